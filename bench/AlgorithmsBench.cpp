@@ -0,0 +1,55 @@
+#include "Bench.h"
+#include "FixedQueueAlgorithms.h"
+#include <numeric>
+
+// the segmented algorithms of FixedQueueAlgorithms.h, against the std:: algorithms on the generic FixedQueueIterator.
+// the front of every queue is in the middle of the buffer, so both segments are processed.
+
+template<typename T>
+void benchType(const std::string& type_name, size_t size)
+{
+	ADS::FixedQueue<T> queue(size);
+
+	for (size_t i = 0; i < size + size / 2; i++)
+		queue.push_back((T)(i % 1000));
+
+	std::vector<T> out(size);
+	Bench::header(type_name + " x " + std::to_string(size) + ", nanoseconds per element");
+
+	auto both = [&](const std::string& name, auto segmented, auto generic) {
+		Bench::report(name + " (ADS)", Bench::nsPerOp([&] { segmented(); Bench::doNotOptimize(out); return size; }));
+		Bench::report(name + " (std)", Bench::nsPerOp([&] { generic(); Bench::doNotOptimize(out); return size; }));
+	};
+
+	both("for_each",
+		[&] { ADS::for_each(queue.begin(), queue.end(), [](T& value) { value += 1; }); },
+		[&] { std::for_each(queue.begin(), queue.end(), [](T& value) { value += 1; }); });
+	both("copy",
+		[&] { ADS::copy(queue.begin(), queue.end(), out.begin()); },
+		[&] { std::copy(queue.begin(), queue.end(), out.begin()); });
+	both("fill",
+		[&] { ADS::fill(queue.begin(), queue.end(), (T)3); },
+		[&] { std::fill(queue.begin(), queue.end(), (T)3); });
+	both("transform",
+		[&] { ADS::transform(queue.begin(), queue.end(), out.begin(), [](T value) { return value * 2; }); },
+		[&] { std::transform(queue.begin(), queue.end(), out.begin(), [](T value) { return value * 2; }); });
+	both("accumulate",
+		[&] { Bench::doNotOptimize(ADS::accumulate(queue.begin(), queue.end(), T())); },
+		[&] { Bench::doNotOptimize(std::accumulate(queue.begin(), queue.end(), T())); });
+	// the value is not in the queue, so the whole range is searched
+	both("find",
+		[&] { Bench::doNotOptimize(ADS::find(queue.begin(), queue.end(), (T)-1)); },
+		[&] { Bench::doNotOptimize(std::find(queue.begin(), queue.end(), (T)-1)); });
+	both("count",
+		[&] { Bench::doNotOptimize(ADS::count(queue.begin(), queue.end(), (T)3)); },
+		[&] { Bench::doNotOptimize(std::count(queue.begin(), queue.end(), (T)3)); });
+}
+
+int main()
+{
+	for (size_t size : { 1 << 10, 1 << 20 })
+	{
+		benchType<int32_t>("int32_t", size);
+		benchType<float>("float", size);
+	}
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include "FixedQueue.h"
+
+// a minimal timing harness shared by the benchmarks in this directory.
+// every benchmark is its own executable printing one line per measurement, so no benchmark library is needed.
+// the minimum time of a measurement can be set in milliseconds with the ADS_BENCH_MS environment variable, the default is 200.
+namespace Bench
+{
+	using Clock = std::chrono::steady_clock;
+
+	// keeps the compiler from removing the computation of value.
+	template<typename T>
+	inline void doNotOptimize(const T& value)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static volatile const void* sink;
+		sink = &value;
+#endif
+	}
+
+	inline std::chrono::nanoseconds minTime()
+	{
+		static const long ms = [] { const char* env = std::getenv("ADS_BENCH_MS"); return env ? std::atol(env) : 200L; }();
+		return std::chrono::milliseconds(ms);
+	}
+
+	class Stopwatch
+	{
+	public:
+		Stopwatch() : m_start(Clock::now()) {}
+
+		void restart() { m_start = Clock::now(); }
+		double seconds() const { return std::chrono::duration<double>(Clock::now() - m_start).count(); }
+		double nanoseconds() const { return std::chrono::duration<double, std::nano>(Clock::now() - m_start).count(); }
+
+	protected:
+		Clock::time_point m_start;
+	};
+
+	// calls func until minTime has passed, and returns the nanoseconds per operation.
+	// func is called once before measuring to warm up caches, and returns the number of operations it performed.
+	template<typename TFunc>
+	double nsPerOp(TFunc&& func)
+	{
+		func();
+
+		size_t ops = 0;
+		Stopwatch watch;
+
+		do
+			ops += func();
+		while (watch.nanoseconds() < minTime().count());
+
+		return watch.nanoseconds() / ops;
+	}
+
+	// returns the q quantile of samples, which are reordered.
+	template<typename T>
+	T percentile(std::vector<T>& samples, double q)
+	{
+		if (samples.empty())
+			return T();
+
+		auto nth = samples.begin() + std::min(samples.size() - 1, (size_t)(q * samples.size()));
+		std::nth_element(samples.begin(), nth, samples.end());
+		return *nth;
+	}
+
+	inline void header(const std::string& title)
+	{
+		std::printf("\n%s\n", title.c_str());
+	}
+
+	// prints a time per operation, with the matching throughput.
+	inline void report(const std::string& name, double ns_per_op)
+	{
+		std::printf("  %-56s %10.2f ns/op %10.2f Mop/s\n", name.c_str(), ns_per_op, 1e3 / ns_per_op);
+	}
+
+	// prints a line of free form values, for results which are not a time per operation.
+	inline void note(const std::string& name, const std::string& values)
+	{
+		std::printf("  %-56s %s\n", name.c_str(), values.c_str());
+	}
+
+	// a FixedQueue behind a mutex, with the interface of the concurrent queues, as the baseline they are measured against.
+	template<typename T>
+	class MutexQueue
+	{
+	public:
+		MutexQueue(size_t size) : m_queue(size) {}
+
+		bool try_push(const T& elem)
+		{
+			std::lock_guard lock(m_mutex);
+
+			if (m_queue.full())
+				return false;
+
+			m_queue.push_back(elem);
+			return true;
+		}
+
+		template<typename TIter>
+		size_t try_push(TIter begin, TIter end)
+		{
+			std::lock_guard lock(m_mutex);
+			size_t count = std::min((size_t)(end - begin), m_queue.size() - m_queue.length());
+
+			m_queue.push_back(begin, begin + count);
+			return count;
+		}
+
+		bool try_pop(T& target) { return try_pop(&target, 1) == 1; }
+
+		size_t try_pop(T* target, size_t elem_count)
+		{
+			std::lock_guard lock(m_mutex);
+			size_t count = std::min(elem_count, m_queue.length());
+
+			m_queue.pop_front(target, count);
+			return count;
+		}
+
+	protected:
+		std::mutex m_mutex;
+		ADS::FixedQueue<T> m_queue;
+	};
+
+	// spins on a failed push / pop, yielding so that the other thread can run on a machine with fewer cores than threads.
+	inline void backoff()
+	{
+		std::this_thread::yield();
+	}
+}
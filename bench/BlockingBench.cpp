@@ -0,0 +1,192 @@
+#include "Bench.h"
+#include "BlockingFixedQueue.h"
+#include "SPSCFixedQueue.h"
+#include <condition_variable>
+#include <ctime>
+
+// BlockingFixedQueue against a FixedQueue with a mutex and two condition variables, and against polling an SPSCFixedQueue.
+// latency bounces one element between two queues, throughput streams elements from one thread to another,
+// and the CPU time of a consumer is measured while the producer only pushes every 100 microseconds.
+
+constexpr size_t QUEUE_SIZE = 1024;
+constexpr size_t ROUND_TRIPS = 20000;
+constexpr size_t ELEMENTS = 1 << 20;
+constexpr size_t SLOW_ELEMENTS = 2000;
+
+class CondVarQueue
+{
+public:
+	CondVarQueue(size_t size) : m_queue(size) {}
+
+	void push(uint64_t elem)
+	{
+		std::unique_lock lock(m_mutex);
+		m_not_full.wait(lock, [&] { return !m_queue.full(); });
+		m_queue.push_back(elem);
+		lock.unlock();
+		m_not_empty.notify_one();
+	}
+
+	void pop(uint64_t& target)
+	{
+		std::unique_lock lock(m_mutex);
+		m_not_empty.wait(lock, [&] { return !m_queue.empty(); });
+		target = m_queue.front();
+		m_queue.pop_front();
+		lock.unlock();
+		m_not_full.notify_one();
+	}
+
+protected:
+	std::mutex m_mutex;
+	std::condition_variable m_not_empty;
+	std::condition_variable m_not_full;
+	ADS::FixedQueue<uint64_t> m_queue;
+};
+
+class BlockingQueue
+{
+public:
+	BlockingQueue(size_t size) : m_queue(size) {}
+
+	void push(uint64_t elem) { m_queue.push_wait(elem); }
+	void pop(uint64_t& target) { m_queue.pop_wait(target); }
+
+protected:
+	ADS::BlockingFixedQueue<uint64_t> m_queue;
+};
+
+// polls without ever sleeping, yielding between attempts so the benchmark also finishes on a single core.
+class PollingQueue
+{
+public:
+	PollingQueue(size_t size) : m_queue(size) {}
+
+	void push(uint64_t elem)
+	{
+		while (!m_queue.try_push(elem))
+			Bench::backoff();
+	}
+
+	void pop(uint64_t& target)
+	{
+		while (!m_queue.try_pop(target))
+			Bench::backoff();
+	}
+
+protected:
+	ADS::SPSCFixedQueue<uint64_t> m_queue;
+};
+
+double threadCpuSeconds()
+{
+	timespec time;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+	return (double)time.tv_sec + (double)time.tv_nsec * 1e-9;
+}
+
+template<typename TQueue>
+void latency(const std::string& name)
+{
+	TQueue ping(QUEUE_SIZE);
+	TQueue pong(QUEUE_SIZE);
+
+	std::thread echo([&] {
+		uint64_t value;
+
+		for (size_t i = 0; i < ROUND_TRIPS; i++)
+		{
+			ping.pop(value);
+			pong.push(value);
+		}
+	});
+
+	std::vector<double> samples;
+	samples.reserve(ROUND_TRIPS);
+
+	for (size_t i = 0; i < ROUND_TRIPS; i++)
+	{
+		uint64_t value = i;
+		Bench::Stopwatch watch;
+
+		ping.push(value);
+		pong.pop(value);
+
+		samples.push_back(watch.nanoseconds() / 2);
+	}
+
+	echo.join();
+
+	char values[128];
+	std::snprintf(values, sizeof(values), "p50 %10.0f ns   p99 %10.0f ns", Bench::percentile(samples, 0.5), Bench::percentile(samples, 0.99));
+	Bench::note(name + " one way latency", values);
+}
+
+template<typename TQueue>
+void throughput(const std::string& name)
+{
+	TQueue queue(QUEUE_SIZE);
+	Bench::Stopwatch watch;
+
+	std::thread producer([&] {
+		for (uint64_t i = 0; i < ELEMENTS; i++)
+			queue.push(i);
+	});
+
+	uint64_t value;
+
+	for (size_t i = 0; i < ELEMENTS; i++)
+		queue.pop(value);
+
+	producer.join();
+	Bench::report(name + " throughput", watch.nanoseconds() / ELEMENTS);
+}
+
+template<typename TQueue>
+void idleCpu(const std::string& name)
+{
+	TQueue queue(QUEUE_SIZE);
+
+	std::thread producer([&] {
+		auto next = std::chrono::steady_clock::now();
+
+		for (uint64_t i = 0; i < SLOW_ELEMENTS; i++)
+		{
+			next += std::chrono::microseconds(100);
+			std::this_thread::sleep_until(next);
+			queue.push(i);
+		}
+	});
+
+	Bench::Stopwatch watch;
+	double cpu_start = threadCpuSeconds();
+	uint64_t value;
+
+	for (size_t i = 0; i < SLOW_ELEMENTS; i++)
+		queue.pop(value);
+
+	double cpu = threadCpuSeconds() - cpu_start;
+	producer.join();
+
+	char values[128];
+	std::snprintf(values, sizeof(values), "%6.1f %% of a core", 100.0 * cpu / watch.seconds());
+	Bench::note(name + " consumer cpu at 10k elements/s", values);
+}
+
+template<typename TQueue>
+void benchQueue(const std::string& name)
+{
+	latency<TQueue>(name);
+	throughput<TQueue>(name);
+	idleCpu<TQueue>(name);
+}
+
+int main()
+{
+	std::printf("%u hardware threads\n", std::thread::hardware_concurrency());
+	Bench::header("two threads, uint64_t elements, queue size " + std::to_string(QUEUE_SIZE));
+
+	benchQueue<BlockingQueue>("BlockingFixedQueue");
+	benchQueue<CondVarQueue>("mutex + condition_variable");
+	benchQueue<PollingQueue>("polling SPSCFixedQueue");
+}
@@ -0,0 +1,80 @@
+#include "Bench.h"
+#include "FixedQueue.h"
+
+// compares wrapping indices with a division (ModCapacity) against a bitmask (Pow2Capacity).
+// both queues get the same power of two size, so the only difference is how indices are wrapped.
+
+template<typename TQueue>
+void benchQueue(const std::string& name, TQueue& queue)
+{
+	constexpr size_t ops = 1 << 16;
+
+	for (size_t i = 0; i < queue.size(); i++)
+		queue.push_back((int)i);
+
+	Bench::report(name + " push_back", Bench::nsPerOp([&] {
+		for (size_t i = 0; i < ops; i++)
+			queue.push_back((int)i);
+
+		Bench::doNotOptimize(queue);
+		return ops;
+	}));
+
+	Bench::report(name + " operator[]", Bench::nsPerOp([&] {
+		int sum = 0;
+
+		// a stride keeps the compiler from turning the loop into a walk over the buffer
+		for (size_t i = 0, index = 0; i < ops; i++, index += 7)
+		{
+			if (index >= queue.length())
+				index -= queue.length();
+
+			sum += queue[index];
+		}
+
+		Bench::doNotOptimize(sum);
+		return ops;
+	}));
+
+	Bench::report(name + " back", Bench::nsPerOp([&] {
+		int sum = 0;
+
+		for (size_t i = 0; i < ops; i++)
+		{
+			queue.push_back((int)i);
+			sum += queue.back();
+		}
+
+		Bench::doNotOptimize(sum);
+		return ops;
+	}));
+}
+
+template<size_t n>
+void benchStatic()
+{
+	// SFixedQueue picks its capacity policy from n, so one less than a power of two falls back to ModCapacity.
+	Bench::header("SFixedQueue<int, " + std::to_string(n - 1) + "> against SFixedQueue<int, " + std::to_string(n) + ">");
+
+	static ADS::SFixedQueue<int, n - 1> mod_queue;
+	static ADS::SFixedQueue<int, n> pow2_queue;
+
+	benchQueue("StaticCapacity<" + std::to_string(n - 1) + "> (mod)", mod_queue);
+	benchQueue("StaticCapacity<" + std::to_string(n) + "> (pow2)", pow2_queue);
+}
+
+int main()
+{
+	for (size_t size : { 1 << 10, 1 << 20 })
+	{
+		Bench::header("FixedQueue<int> of size " + std::to_string(size));
+
+		ADS::FixedQueue<int, ADS::ModCapacity> mod_queue(size);
+		ADS::FixedQueue<int, ADS::Pow2Capacity> pow2_queue(size);
+
+		benchQueue("ModCapacity", mod_queue);
+		benchQueue("Pow2Capacity", pow2_queue);
+	}
+
+	benchStatic<1024>();
+}
@@ -0,0 +1,127 @@
+#include "Bench.h"
+#include "Scheduler.h"
+#include "FixedQueueChannel.h"
+
+// FixedQueueChannel between coroutines on a single thread, driven by the scheduler in tests/Scheduler.h.
+// ping-pong bounces a value between two coroutines through two channels, so every hop suspends and resumes a coroutine.
+// streaming passes elements from producers to a consumer, where a coroutine only suspends when the channel is full or empty.
+// pushing and popping a plain FixedQueue in a loop is measured as the cost without coroutines.
+
+constexpr size_t ROUND_TRIPS = 1 << 20;
+constexpr size_t ELEMENTS = 1 << 22;
+
+using Channel = ADS::FixedQueueChannel<uint64_t>;
+
+Test::Task ping(Channel& to, Channel& from, size_t round_trips)
+{
+	for (uint64_t i = 0; i < round_trips; i++)
+	{
+		co_await to.push(i);
+		Bench::doNotOptimize(co_await from.pop());
+	}
+
+	to.close();
+}
+
+Test::Task pong(Channel& from, Channel& to)
+{
+	while (std::optional<uint64_t> value = co_await from.pop())
+		co_await to.push(*value + 1);
+}
+
+Test::Task produce(Channel& channel, uint64_t count)
+{
+	for (uint64_t i = 0; i < count; i++)
+		co_await channel.push(i);
+}
+
+// like produce, but lets every other ready task run after each push, like a task which also waits for other work
+Test::Task produceYielding(Test::Scheduler& scheduler, Channel& channel, uint64_t count)
+{
+	for (uint64_t i = 0; i < count; i++)
+	{
+		co_await channel.push(i);
+		co_await scheduler.yield();
+	}
+}
+
+Test::Task consume(Channel& channel, uint64_t count, uint64_t& sum)
+{
+	for (uint64_t i = 0; i < count; i++)
+		sum += *co_await channel.pop();
+
+	channel.close();
+}
+
+double pingPong(size_t channel_size)
+{
+	Channel to(channel_size);
+	Channel from(channel_size);
+	Test::Scheduler scheduler;
+
+	scheduler.spawn(pong(to, from));
+	scheduler.spawn(ping(to, from, ROUND_TRIPS));
+
+	Bench::Stopwatch watch;
+
+	if (!scheduler.run())
+		std::printf("  ping-pong did not finish\n");
+
+	// two hops per round trip
+	return watch.nanoseconds() / (2 * ROUND_TRIPS);
+}
+
+double stream(size_t channel_size, size_t producers, bool yielding = false)
+{
+	Channel channel(channel_size);
+	Test::Scheduler scheduler;
+	uint64_t sum = 0;
+
+	for (size_t p = 0; p < producers; p++)
+	{
+		if (yielding)
+			scheduler.spawn(produceYielding(scheduler, channel, ELEMENTS / producers));
+		else
+			scheduler.spawn(produce(channel, ELEMENTS / producers));
+	}
+
+	scheduler.spawn(consume(channel, ELEMENTS / producers * producers, sum));
+
+	Bench::Stopwatch watch;
+
+	if (!scheduler.run())
+		std::printf("  stream did not finish\n");
+
+	Bench::doNotOptimize(sum);
+	return watch.nanoseconds() / (ELEMENTS / producers * producers);
+}
+
+int main()
+{
+	Bench::header("single thread, uint64_t elements");
+
+	for (size_t size : { 0, 1, 64 })
+		Bench::report("ping-pong per hop, channel size " + std::to_string(size), pingPong(size));
+
+	for (size_t size : { 1, 64, 1024 })
+		Bench::report("stream 1 producer, channel size " + std::to_string(size), stream(size, 1));
+
+	Bench::report("stream 4 producers, channel size 64", stream(64, 4));
+	Bench::report("stream 4 yielding producers, channel size 64", stream(64, 4, true));
+
+	ADS::FixedQueue<uint64_t> queue(64);
+
+	Bench::report("FixedQueue push + pop without coroutines", Bench::nsPerOp([&] {
+		uint64_t sum = 0;
+
+		for (uint64_t i = 0; i < 4096; i++)
+		{
+			queue.push_back(i);
+			sum += queue.front();
+			queue.pop_front();
+		}
+
+		Bench::doNotOptimize(sum);
+		return 4096;
+	}));
+}
@@ -0,0 +1,132 @@
+#include "Bench.h"
+#include "CompressedFixedQueue.h"
+#include <cmath>
+#include <numeric>
+#include <random>
+
+// CompressedFixedQueue against FixedQueue on typical telemetry series: the compression ratio,
+// and the time to push an element and to scan all elements, both with the iterator and with the block aggregates.
+
+constexpr size_t SIZE = 1 << 20;
+
+// each series is generated once, and pushed into both queues
+std::vector<int64_t> timestamps()
+{
+	// milliseconds at a fixed rate with a little jitter
+	std::mt19937 rng(1);
+	std::vector<int64_t> values(SIZE);
+	int64_t time = 1700000000000;
+
+	for (int64_t& value : values)
+		value = time += 1000 + (int64_t)(rng() % 3) - 1;
+
+	return values;
+}
+
+std::vector<int64_t> counters()
+{
+	// a slowly increasing counter
+	std::mt19937 rng(2);
+	std::vector<int64_t> values(SIZE);
+	int64_t count = 0;
+
+	for (int64_t& value : values)
+		value = count += rng() % 16;
+
+	return values;
+}
+
+std::vector<double> gauges()
+{
+	// a sensor value which often repeats and otherwise changes slowly
+	std::mt19937 rng(3);
+	std::vector<double> values(SIZE);
+	double value = 20.0;
+
+	for (double& gauge : values)
+	{
+		if (rng() % 4 == 0)
+			value = std::round((value + ((double)(rng() % 21) - 10.0) * 0.01) * 100.0) / 100.0;
+
+		gauge = value;
+	}
+
+	return values;
+}
+
+std::vector<double> noise()
+{
+	// random doubles, the worst case for the xor encoding
+	std::mt19937_64 rng(4);
+	std::uniform_real_distribution<double> distribution(0.0, 1.0);
+	std::vector<double> values(SIZE);
+
+	for (double& value : values)
+		value = distribution(rng);
+
+	return values;
+}
+
+template<typename T>
+void benchSeries(const std::string& name, const std::vector<T>& values)
+{
+	Bench::header(name + ", " + std::to_string(SIZE) + " elements");
+
+	ADS::CompressedFixedQueue<T> compressed(SIZE);
+	ADS::FixedQueue<T> plain(SIZE);
+
+	for (T value : values)
+	{
+		compressed.push_back(value);
+		plain.push_back(value);
+	}
+
+	char ratio[64];
+	std::snprintf(ratio, sizeof(ratio), "%.2fx (%zu bytes against %zu)", compressed.compressionRatio(), compressed.compressedBytes(), SIZE * sizeof(T));
+	Bench::note("compression ratio", ratio);
+
+	size_t next = 0;
+
+	Bench::report("push (CompressedFixedQueue)", Bench::nsPerOp([&] {
+		for (size_t i = 0; i < 4096; i++)
+			compressed.push_back(values[next++ % SIZE]);
+		return 4096;
+	}));
+
+	Bench::report("push (FixedQueue)", Bench::nsPerOp([&] {
+		for (size_t i = 0; i < 4096; i++)
+			plain.push_back(values[next++ % SIZE]);
+		return 4096;
+	}));
+
+	Bench::report("scan with iterator (CompressedFixedQueue)", Bench::nsPerOp([&] {
+		Bench::doNotOptimize(std::accumulate(compressed.begin(), compressed.end(), T()));
+		return compressed.length();
+	}));
+
+	Bench::report("scan with iterator (FixedQueue)", Bench::nsPerOp([&] {
+		Bench::doNotOptimize(std::accumulate(plain.begin(), plain.end(), T()));
+		return plain.length();
+	}));
+
+	// the compressed queue keeps the sum, min and max of every block, so it only decodes the partial blocks at the ends
+	Bench::report("avg + max per query (CompressedFixedQueue)", Bench::nsPerOp([&] {
+		Bench::doNotOptimize(compressed.avg());
+		Bench::doNotOptimize(compressed.max());
+		return 1;
+	}));
+
+	Bench::report("avg + max per query (FixedQueue)", Bench::nsPerOp([&] {
+		Bench::doNotOptimize(plain.avg());
+		Bench::doNotOptimize(plain.max());
+		return 1;
+	}));
+}
+
+int main()
+{
+	benchSeries("int64_t timestamps", timestamps());
+	benchSeries("int64_t counter", counters());
+	benchSeries("double gauge", gauges());
+	benchSeries("double noise", noise());
+}
@@ -0,0 +1,92 @@
+#include "Bench.h"
+#include "FixedQueue.h"
+#include <random>
+#include <ranges>
+
+// standard algorithms on FixedQueueIterator, against the same algorithms on std::vector as the best case.
+// the front of the queue is in the middle of the buffer, so the algorithms run across the wrap.
+
+constexpr size_t SIZE = 1 << 18;
+
+std::vector<int> randomValues()
+{
+	std::mt19937 rng(7);
+	std::vector<int> values(SIZE);
+
+	for (int& value : values)
+		value = (int)(rng() % 1000000);
+
+	return values;
+}
+
+// fills a wrapped queue with values
+void load(ADS::FixedQueue<int>& queue, const std::vector<int>& values)
+{
+	queue.clear();
+
+	for (size_t i = 0; i < SIZE / 2; i++)
+		queue.push_back(0);
+
+	queue.pop_front(SIZE / 2);
+	queue.push_back(values.begin(), values.end());
+}
+
+// times func on a fresh copy of the input for both containers, so algorithms which modify the range start from the same state
+template<typename TFunc>
+void bench(const std::string& name, const std::vector<int>& values, TFunc func)
+{
+	ADS::FixedQueue<int> queue(SIZE);
+	std::vector<int> vector;
+
+	Bench::report(name + " (FixedQueue)", Bench::nsPerOp([&] {
+		load(queue, values);
+		func(queue.begin(), queue.end());
+		Bench::doNotOptimize(queue);
+		return SIZE;
+	}));
+
+	Bench::report(name + " (std::vector)", Bench::nsPerOp([&] {
+		vector = values;
+		func(vector.begin(), vector.end());
+		Bench::doNotOptimize(vector);
+		return SIZE;
+	}));
+}
+
+int main()
+{
+	std::vector<int> values = randomValues();
+	std::vector<int> sorted = values;
+	std::sort(sorted.begin(), sorted.end());
+
+	static_assert(std::random_access_iterator<ADS::FixedQueueIterator<int>>);
+	static_assert(std::ranges::random_access_range<ADS::FixedQueue<int>>);
+
+	Bench::header(std::to_string(SIZE) + " ints, nanoseconds per element including reloading the input");
+
+	bench("reload only", values, [](auto, auto) {});
+	bench("std::sort", values, [](auto first, auto last) { std::sort(first, last); });
+	bench("std::ranges::sort", values, [](auto first, auto last) { std::ranges::sort(std::ranges::subrange(first, last)); });
+	bench("std::nth_element", values, [](auto first, auto last) { std::nth_element(first, first + (last - first) / 2, last); });
+	bench("std::reverse", values, [](auto first, auto last) { std::reverse(first, last); });
+	bench("std::max_element", values, [](auto first, auto last) { Bench::doNotOptimize(*std::max_element(first, last)); });
+
+	// lookups on a sorted range, the input is loaded once
+	Bench::header(std::to_string(SIZE) + " sorted ints, nanoseconds per lookup");
+
+	ADS::FixedQueue<int> queue(SIZE);
+	load(queue, sorted);
+	std::mt19937 rng(11);
+
+	Bench::report("std::lower_bound (FixedQueue)", Bench::nsPerOp([&] {
+		for (int i = 0; i < 1024; i++)
+			Bench::doNotOptimize(std::lower_bound(queue.begin(), queue.end(), (int)(rng() % 1000000)));
+		return 1024;
+	}));
+
+	Bench::report("std::lower_bound (std::vector)", Bench::nsPerOp([&] {
+		for (int i = 0; i < 1024; i++)
+			Bench::doNotOptimize(std::lower_bound(sorted.begin(), sorted.end(), (int)(rng() % 1000000)));
+		return 1024;
+	}));
+}
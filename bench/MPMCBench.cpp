@@ -0,0 +1,71 @@
+#include "Bench.h"
+#include "MPMCFixedQueue.h"
+#include <atomic>
+
+// throughput of MPMCFixedQueue with 1..N producers and 1..N consumers, against a FixedQueue behind a mutex.
+// N is the number of hardware threads, but at least 4 so the contended cases are always measured.
+
+constexpr size_t QUEUE_SIZE = 1024;
+constexpr size_t ELEMENTS = 1 << 21;
+
+template<typename TQueue>
+double throughput(size_t producers, size_t consumers)
+{
+	TQueue queue(QUEUE_SIZE);
+	std::atomic<size_t> received = 0;
+	std::vector<std::thread> threads;
+
+	Bench::Stopwatch watch;
+
+	for (size_t p = 0; p < producers; p++)
+	{
+		threads.emplace_back([&, p] {
+			// the elements are split evenly, the first producer also takes the remainder
+			size_t count = ELEMENTS / producers + (p == 0 ? ELEMENTS % producers : 0);
+
+			for (size_t i = 0; i < count; i++)
+				while (!queue.try_push(i))
+					Bench::backoff();
+		});
+	}
+
+	for (size_t c = 0; c < consumers; c++)
+	{
+		threads.emplace_back([&] {
+			uint64_t value;
+
+			while (received.load(std::memory_order_relaxed) < ELEMENTS)
+			{
+				if (queue.try_pop(value))
+					received.fetch_add(1, std::memory_order_relaxed);
+				else
+					Bench::backoff();
+			}
+		});
+	}
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	return watch.nanoseconds() / ELEMENTS;
+}
+
+int main()
+{
+	size_t max_threads = std::max(4u, std::thread::hardware_concurrency());
+
+	std::printf("%u hardware threads\n", std::thread::hardware_concurrency());
+	Bench::header("uint64_t elements, queue size " + std::to_string(QUEUE_SIZE));
+
+	for (size_t producers = 1; producers <= max_threads; producers *= 2)
+	{
+		for (size_t consumers = 1; consumers <= max_threads; consumers *= 2)
+		{
+			std::string threads = std::to_string(producers) + "P/" + std::to_string(consumers) + "C";
+
+			Bench::report("MPMCFixedQueue " + threads, throughput<ADS::MPMCFixedQueue<uint64_t>>(producers, consumers));
+			Bench::report("MPMCFixedQueue<Pow2Capacity> " + threads, throughput<ADS::MPMCFixedQueue<uint64_t, ADS::Pow2Capacity>>(producers, consumers));
+			Bench::report("mutex + FixedQueue " + threads, throughput<Bench::MutexQueue<uint64_t>>(producers, consumers));
+		}
+	}
+}
@@ -0,0 +1,135 @@
+#include "Bench.h"
+#include "FixedQueue.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// pushes of heavy element types into a full FixedQueue, copying against moving and constructing in place.
+// next to the time, the heap allocations per push are counted by replacing the global operator new.
+
+std::atomic<size_t> g_allocations = 0;
+
+void* operator new(size_t size)
+{
+	g_allocations.fetch_add(1, std::memory_order_relaxed);
+
+	if (void* ptr = std::malloc(size ? size : 1))
+		return ptr;
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+struct Message
+{
+	Message() = default;
+	Message(uint64_t id, const std::string& topic, size_t payload_size)
+		: id(id), topic(topic), payload(payload_size, (uint8_t)id) {}
+
+	uint64_t id = 0;
+	std::string topic;
+	std::vector<uint8_t> payload;
+};
+
+constexpr size_t QUEUE_SIZE = 1024;
+constexpr size_t BATCH = 256;
+
+// times func, which pushes BATCH elements, and prints the time and allocations per push.
+// make prepares the elements outside of the measurement, so only the push itself is counted.
+template<typename T, typename TMake, typename TPush>
+void bench(const std::string& name, TMake make, TPush push)
+{
+	ADS::FixedQueue<T> queue(QUEUE_SIZE);
+	std::vector<T> source;
+
+	// fill the queue first, so every push overwrites an element like in a steady state
+	for (size_t i = 0; i < QUEUE_SIZE; i++)
+		queue.push_back(make(i));
+
+	double total_ns = 0;
+	size_t allocations = 0;
+	size_t pushes = 0;
+
+	Bench::Stopwatch total;
+
+	while (total.nanoseconds() < Bench::minTime().count())
+	{
+		source.clear();
+
+		for (size_t i = 0; i < BATCH; i++)
+			source.push_back(make(pushes + i));
+
+		size_t allocations_before = g_allocations.load(std::memory_order_relaxed);
+		Bench::Stopwatch watch;
+
+		push(queue, source);
+
+		total_ns += watch.nanoseconds();
+		allocations += g_allocations.load(std::memory_order_relaxed) - allocations_before;
+		pushes += BATCH;
+	}
+
+	char values[128];
+	std::snprintf(values, sizeof(values), "%10.2f ns/push %8.2f allocations/push", total_ns / pushes, (double)allocations / pushes);
+	Bench::note(name, values);
+}
+
+int main()
+{
+	const std::string long_text(100, 'x');
+	auto make_string = [&](size_t i) { return long_text + std::to_string(i); };
+
+	Bench::header("std::string of 100+ characters, queue size " + std::to_string(QUEUE_SIZE));
+
+	bench<std::string>("push_back(const T&)", make_string, [](auto& queue, auto& source) {
+		for (const std::string& elem : source)
+			queue.push_back(elem);
+	});
+	bench<std::string>("push_back(T&&)", make_string, [](auto& queue, auto& source) {
+		for (std::string& elem : source)
+			queue.push_back(std::move(elem));
+	});
+	bench<std::string>("emplace_back(const char*, size_t)", make_string, [](auto& queue, auto& source) {
+		for (const std::string& elem : source)
+			queue.emplace_back(elem.data(), elem.size());
+	});
+	bench<std::string>("push_back(const std::vector<T>&)", make_string, [](auto& queue, auto& source) {
+		queue.push_back(source);
+	});
+	bench<std::string>("push_back(std::vector<T>&&)", make_string, [](auto& queue, auto& source) {
+		queue.push_back(std::move(source));
+	});
+
+	auto make_message = [&](size_t i) { return Message(i, "telemetry/" + long_text, 256); };
+
+	Bench::header("Message with a std::string topic and a 256 byte payload, queue size " + std::to_string(QUEUE_SIZE));
+
+	bench<Message>("push_back(const T&)", make_message, [](auto& queue, auto& source) {
+		for (const Message& elem : source)
+			queue.push_back(elem);
+	});
+	bench<Message>("push_back(T&&)", make_message, [](auto& queue, auto& source) {
+		for (Message& elem : source)
+			queue.push_back(std::move(elem));
+	});
+	bench<Message>("emplace_back(id, topic, size)", make_message, [](auto& queue, auto& source) {
+		for (const Message& elem : source)
+			queue.emplace_back(elem.id, elem.topic, elem.payload.size());
+	});
+	bench<Message>("push_back(std::vector<T>&&)", make_message, [](auto& queue, auto& source) {
+		queue.push_back(std::move(source));
+	});
+
+	Bench::header("draining a full queue of Message into a buffer");
+
+	bench<Message>("pop_front(T*, count) moving out + push_back(T&&)", make_message, [](auto& queue, auto& source) {
+		static std::vector<Message> drained(BATCH);
+
+		queue.pop_front(drained.data(), BATCH);
+
+		for (Message& elem : source)
+			queue.push_back(std::move(elem));
+	});
+}
@@ -0,0 +1,52 @@
+#include "Bench.h"
+#include "FixedQueueParallel.h"
+
+// scaling of the Parallel aggregates over a large FixedQueue<float>, from 1 thread to all hardware threads.
+// the single threaded FixedQueueBase aggregates are measured first as the baseline.
+
+constexpr size_t SIZE = 1 << 24;
+
+int main()
+{
+	ADS::FixedQueue<float> queue(SIZE);
+
+	// wrapped, so both segments are split into chunks
+	for (size_t i = 0; i < SIZE + SIZE / 3; i++)
+		queue.push_back((float)(i % 10007) * 0.5f);
+
+	std::vector<float> out(SIZE);
+
+	size_t hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+	std::vector<size_t> thread_counts;
+
+	for (size_t threads = 1; threads < hardware_threads; threads *= 2)
+		thread_counts.push_back(threads);
+
+	thread_counts.push_back(hardware_threads);
+
+	std::printf("%zu hardware threads\n", hardware_threads);
+	Bench::header("FixedQueue<float> x " + std::to_string(SIZE) + " single threaded, nanoseconds per element");
+
+	Bench::report("avg", Bench::nsPerOp([&] { Bench::doNotOptimize(queue.avg()); return SIZE; }));
+	Bench::report("max", Bench::nsPerOp([&] { Bench::doNotOptimize(queue.max()); return SIZE; }));
+	Bench::report("iOfMax", Bench::nsPerOp([&] { Bench::doNotOptimize(queue.iOfMax()); return SIZE; }));
+
+	for (size_t threads : thread_counts)
+	{
+		Bench::header("Parallel with " + std::to_string(threads) + " threads, nanoseconds per element");
+
+		Bench::report("avg", Bench::nsPerOp([&] { Bench::doNotOptimize(ADS::Parallel::avg(queue, threads)); return SIZE; }));
+		Bench::report("max", Bench::nsPerOp([&] { Bench::doNotOptimize(ADS::Parallel::max(queue, threads)); return SIZE; }));
+		Bench::report("min", Bench::nsPerOp([&] { Bench::doNotOptimize(ADS::Parallel::min(queue, threads)); return SIZE; }));
+		Bench::report("iOfMax", Bench::nsPerOp([&] { Bench::doNotOptimize(ADS::Parallel::iOfMax(queue, threads)); return SIZE; }));
+		Bench::report("reduce (sum of squares)", Bench::nsPerOp([&] {
+			Bench::doNotOptimize(ADS::Parallel::reduce(queue.begin(), queue.end(), 0.0, [](double sum, float value) { return sum + (double)value * value; }, threads));
+			return SIZE;
+		}));
+		Bench::report("transform", Bench::nsPerOp([&] {
+			ADS::Parallel::transform(queue.begin(), queue.end(), out.begin(), [](float value) { return value * 2.0f + 1.0f; }, threads);
+			Bench::doNotOptimize(out);
+			return SIZE;
+		}));
+	}
+}
@@ -0,0 +1,104 @@
+#include "Bench.h"
+#include "FixedQueue.h"
+#include <random>
+
+// quantile queries on a sliding window of latencies, comparing QuantileTracker against copying the window and running nth_element,
+// which is what quantile() does without a tracker.
+// accuracy: the tracker is exact, so every quantile it returns is compared against nth_element over the same window.
+
+// latencies in microseconds, mostly around 200 with a long tail, so many values repeat like in real measurements.
+std::vector<uint32_t> latencies(size_t count)
+{
+	std::mt19937 rng(42);
+	std::lognormal_distribution<double> distribution(5.3, 0.6);
+	std::vector<uint32_t> values(count);
+
+	for (uint32_t& value : values)
+		value = (uint32_t)distribution(rng);
+
+	return values;
+}
+
+uint32_t nthElementQuantile(const ADS::FixedQueue<uint32_t>& queue, double q)
+{
+	std::vector<uint32_t> sorted(queue.begin(), queue.end());
+	size_t rank = ADS::QuantileTracker<uint32_t>::quantileRank(q, sorted.size());
+
+	std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+	return sorted[rank];
+}
+
+void benchWindow(size_t window)
+{
+	Bench::header("window of " + std::to_string(window) + " uint32_t latencies");
+
+	std::vector<uint32_t> values = latencies(window * 4);
+	ADS::FixedQueue<uint32_t> plain(window);
+	ADS::FixedQueue<uint32_t, ADS::ModCapacity, ADS::QuantileTracker<uint32_t>> tracked(window);
+
+	size_t next = 0;
+	auto nextValue = [&] { return values[next++ % values.size()]; };
+
+	Bench::report("push, no tracker", Bench::nsPerOp([&] {
+		for (size_t i = 0; i < 4096; i++)
+			plain.push_back(nextValue());
+		return 4096;
+	}));
+
+	Bench::report("push, QuantileTracker", Bench::nsPerOp([&] {
+		for (size_t i = 0; i < 4096; i++)
+			tracked.push_back(nextValue());
+		return 4096;
+	}));
+
+	Bench::report("p99 query, copy + nth_element", Bench::nsPerOp([&] { Bench::doNotOptimize(nthElementQuantile(plain, 0.99)); return 1; }));
+	Bench::report("p99 query, QuantileTracker", Bench::nsPerOp([&] { Bench::doNotOptimize(tracked.quantile(0.99)); return 1; }));
+
+	// a dashboard refreshing p50 and p99 after every 100 samples
+	Bench::report("100 pushes + p50 + p99, copy + nth_element", Bench::nsPerOp([&] {
+		for (size_t i = 0; i < 100; i++)
+			plain.push_back(nextValue());
+
+		Bench::doNotOptimize(nthElementQuantile(plain, 0.5));
+		Bench::doNotOptimize(nthElementQuantile(plain, 0.99));
+		return 1;
+	}));
+
+	Bench::report("100 pushes + p50 + p99, QuantileTracker", Bench::nsPerOp([&] {
+		for (size_t i = 0; i < 100; i++)
+			tracked.push_back(nextValue());
+
+		Bench::doNotOptimize(tracked.quantile(0.5));
+		Bench::doNotOptimize(tracked.quantile(0.99));
+		return 1;
+	}));
+
+	// both queues slide over the same values, and are compared at many points
+	ADS::FixedQueue<uint32_t> reference(window);
+	ADS::FixedQueue<uint32_t, ADS::ModCapacity, ADS::QuantileTracker<uint32_t>> checked(window);
+	size_t queries = 0;
+	size_t mismatches = 0;
+
+	for (size_t i = 0; i < values.size(); i++)
+	{
+		reference.push_back(values[i]);
+		checked.push_back(values[i]);
+
+		if (i % (window / 8 + 1) != 0)
+			continue;
+
+		for (double q : { 0.0, 0.5, 0.9, 0.99, 0.999, 1.0 })
+		{
+			mismatches += checked.quantile(q) != nthElementQuantile(reference, q);
+			queries++;
+		}
+	}
+
+	Bench::note("accuracy against nth_element", std::to_string(queries - mismatches) + " of " + std::to_string(queries) + " quantiles equal");
+}
+
+int main()
+{
+	for (size_t window : { 1 << 10, 1 << 14, 1 << 18 })
+		benchWindow(window);
+}
@@ -0,0 +1,52 @@
+#include "Bench.h"
+#include "FixedQueue.h"
+#include <numeric>
+
+// max, min and avg of a FixedQueue without a tracker, which reduce the two raw segments with the SIMD kernels,
+// against the element by element walk over FixedQueueIterator they replaced.
+// the front of every queue is in the middle of the buffer, so both segments are reduced.
+
+const char* instructionSetName(ADS::SIMD::InstructionSet set)
+{
+	switch (set)
+	{
+	case ADS::SIMD::InstructionSet::AVX512: return "AVX-512";
+	case ADS::SIMD::InstructionSet::AVX2: return "AVX2";
+	case ADS::SIMD::InstructionSet::SSE2: return "SSE2";
+	default: return "scalar";
+	}
+}
+
+template<typename T>
+void benchType(const std::string& type_name, size_t size)
+{
+	ADS::FixedQueue<T> queue(size);
+
+	// one and a half laps, so the front ends up in the middle of the buffer
+	for (size_t i = 0; i < size + size / 2; i++)
+		queue.push_back((T)((i * 7919) % 1000));
+
+	std::string name = type_name + " x " + std::to_string(size);
+	size_t length = queue.length();
+
+	Bench::report(name + " max (simd)", Bench::nsPerOp([&] { Bench::doNotOptimize(queue.max()); return length; }));
+	Bench::report(name + " max (iterator)", Bench::nsPerOp([&] { Bench::doNotOptimize(*std::max_element(queue.begin(), queue.end())); return length; }));
+	Bench::report(name + " min (simd)", Bench::nsPerOp([&] { Bench::doNotOptimize(queue.min()); return length; }));
+	Bench::report(name + " min (iterator)", Bench::nsPerOp([&] { Bench::doNotOptimize(*std::min_element(queue.begin(), queue.end())); return length; }));
+	Bench::report(name + " avg (simd)", Bench::nsPerOp([&] { Bench::doNotOptimize(queue.avg()); return length; }));
+	Bench::report(name + " avg (iterator)", Bench::nsPerOp([&] { Bench::doNotOptimize(std::accumulate(queue.begin(), queue.end(), T()) / (T)length); return length; }));
+}
+
+int main()
+{
+	std::printf("instruction set: %s\n", instructionSetName(ADS::SIMD::instructionSet()));
+	Bench::header("nanoseconds per element");
+
+	for (size_t size : { 64, 1 << 10, 1 << 16, 1 << 20, 1 << 24 })
+	{
+		benchType<int32_t>("int32_t", size);
+		benchType<int64_t>("int64_t", size);
+		benchType<float>("float", size);
+		benchType<double>("double", size);
+	}
+}
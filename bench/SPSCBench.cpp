@@ -0,0 +1,120 @@
+#include "Bench.h"
+#include "SPSCFixedQueue.h"
+
+// one producer and one consumer thread, comparing SPSCFixedQueue against a FixedQueue behind a mutex.
+// throughput passes a fixed number of elements through the queue, one by one and in batches.
+// latency bounces one element between two queues, and reports half of the round trip.
+
+constexpr size_t QUEUE_SIZE = 1024;
+constexpr size_t ELEMENTS = 1 << 22;
+constexpr size_t BATCH = 64;
+constexpr size_t ROUND_TRIPS = 20000;
+
+template<typename TQueue>
+double throughput(size_t batch)
+{
+	TQueue queue(QUEUE_SIZE);
+	Bench::Stopwatch watch;
+
+	std::thread producer([&] {
+		uint64_t buffer[BATCH];
+
+		for (size_t sent = 0; sent < ELEMENTS;)
+		{
+			size_t count = std::min(batch, ELEMENTS - sent);
+
+			for (size_t i = 0; i < count; i++)
+				buffer[i] = sent + i;
+
+			size_t pushed = batch == 1 ? queue.try_push(buffer[0]) : queue.try_push(buffer, buffer + count);
+
+			if (pushed == 0)
+				Bench::backoff();
+
+			sent += pushed;
+		}
+	});
+
+	uint64_t buffer[BATCH];
+	uint64_t checksum = 0;
+
+	for (size_t received = 0; received < ELEMENTS;)
+	{
+		size_t popped = queue.try_pop(buffer, batch);
+
+		if (popped == 0)
+			Bench::backoff();
+
+		for (size_t i = 0; i < popped; i++)
+			checksum += buffer[i];
+
+		received += popped;
+	}
+
+	producer.join();
+
+	if (checksum != (uint64_t)ELEMENTS * (ELEMENTS - 1) / 2)
+		std::printf("  checksum mismatch, elements were lost\n");
+
+	return watch.nanoseconds() / ELEMENTS;
+}
+
+template<typename TQueue>
+void latency(const std::string& name)
+{
+	TQueue ping(QUEUE_SIZE);
+	TQueue pong(QUEUE_SIZE);
+
+	std::thread echo([&] {
+		uint64_t value;
+
+		for (size_t i = 0; i < ROUND_TRIPS; i++)
+		{
+			while (!ping.try_pop(value))
+				Bench::backoff();
+
+			while (!pong.try_push(value))
+				Bench::backoff();
+		}
+	});
+
+	std::vector<double> samples;
+	samples.reserve(ROUND_TRIPS);
+
+	for (size_t i = 0; i < ROUND_TRIPS; i++)
+	{
+		uint64_t value = i;
+		Bench::Stopwatch watch;
+
+		while (!ping.try_push(value))
+			Bench::backoff();
+
+		while (!pong.try_pop(value))
+			Bench::backoff();
+
+		samples.push_back(watch.nanoseconds() / 2);
+	}
+
+	echo.join();
+
+	char values[128];
+	std::snprintf(values, sizeof(values), "p50 %10.0f ns   p99 %10.0f ns", Bench::percentile(samples, 0.5), Bench::percentile(samples, 0.99));
+	Bench::note(name + " one way latency", values);
+}
+
+template<typename TQueue>
+void benchQueue(const std::string& name)
+{
+	Bench::report(name + " throughput", throughput<TQueue>(1));
+	Bench::report(name + " throughput, batches of " + std::to_string(BATCH), throughput<TQueue>(BATCH));
+	latency<TQueue>(name);
+}
+
+int main()
+{
+	std::printf("%u hardware threads, with fewer than 2 both threads share a core\n", std::thread::hardware_concurrency());
+	Bench::header("two threads, uint64_t elements, queue size " + std::to_string(QUEUE_SIZE));
+
+	benchQueue<ADS::SPSCFixedQueue<uint64_t>>("SPSCFixedQueue");
+	benchQueue<Bench::MutexQueue<uint64_t>>("mutex + FixedQueue");
+}
@@ -0,0 +1,136 @@
+#include "Bench.h"
+#include "SharedFixedQueue.h"
+#include <unistd.h>
+#include <sys/wait.h>
+
+// throughput between processes: producer processes attach to a SharedFixedQueue created by the consuming parent process.
+// a pipe carrying the same elements is measured as the baseline.
+
+constexpr size_t QUEUE_SIZE = 4096;
+constexpr uint64_t ELEMENTS = 1 << 21;
+
+const std::string NAME = "/ADS-SharedBench-" + std::to_string(getpid());
+
+// runs func in a child process, which exits without running the destructors of the parent's objects
+template<typename TFunc>
+pid_t spawn(TFunc func)
+{
+	pid_t pid = fork();
+
+	if (pid == 0)
+	{
+		func();
+		_exit(0);
+	}
+
+	return pid;
+}
+
+template<bool multi_producer>
+double sharedThroughput(size_t producers, bool wakeup)
+{
+	ADS::SharedFixedQueue<uint64_t, multi_producer> queue(NAME, QUEUE_SIZE, wakeup);
+	std::vector<pid_t> children;
+
+	Bench::Stopwatch watch;
+
+	for (size_t p = 0; p < producers; p++)
+	{
+		children.push_back(spawn([p, producers] {
+			ADS::SharedFixedQueue<uint64_t, multi_producer> attached(NAME);
+			uint64_t count = ELEMENTS / producers + (p == 0 ? ELEMENTS % producers : 0);
+
+			for (uint64_t i = 0; i < count; i++)
+				while (!attached.try_push(i))
+					Bench::backoff();
+		}));
+	}
+
+	uint64_t received = 0;
+	uint64_t buffer[256];
+
+	while (received < ELEMENTS)
+	{
+		if (wakeup)
+		{
+			queue.pop_wait(buffer[0]);
+			received += 1 + queue.try_pop(buffer + 1, 255);
+		}
+		else
+		{
+			size_t popped = queue.try_pop(buffer, 256);
+
+			if (popped == 0)
+				Bench::backoff();
+
+			received += popped;
+		}
+	}
+
+	double ns = watch.nanoseconds();
+
+	for (pid_t child : children)
+		waitpid(child, nullptr, 0);
+
+	return ns / ELEMENTS;
+}
+
+double pipeThroughput()
+{
+	int fds[2];
+
+	if (pipe(fds) != 0)
+		return 0;
+
+	Bench::Stopwatch watch;
+
+	pid_t child = spawn([&] {
+		close(fds[0]);
+		uint64_t buffer[256];
+
+		for (uint64_t sent = 0; sent < ELEMENTS; sent += 256)
+		{
+			for (uint64_t i = 0; i < 256; i++)
+				buffer[i] = sent + i;
+
+			if (write(fds[1], buffer, sizeof(buffer)) != (ssize_t)sizeof(buffer))
+				_exit(1);
+		}
+	});
+
+	close(fds[1]);
+
+	uint64_t buffer[256];
+	size_t bytes = 0;
+
+	while (bytes < ELEMENTS * sizeof(uint64_t))
+	{
+		ssize_t result = read(fds[0], buffer, sizeof(buffer));
+
+		if (result <= 0)
+			break;
+
+		bytes += result;
+	}
+
+	double ns = watch.nanoseconds();
+
+	close(fds[0]);
+	waitpid(child, nullptr, 0);
+
+	return ns / ELEMENTS;
+}
+
+int main()
+{
+	std::printf("%u hardware threads\n", std::thread::hardware_concurrency());
+	Bench::header("uint64_t elements between processes, queue size " + std::to_string(QUEUE_SIZE) + ", including process start up");
+
+	Bench::report("SharedFixedQueue 1 producer, polling", sharedThroughput<false>(1, false));
+	Bench::report("SharedFixedQueue 1 producer, pop_wait with wakeup", sharedThroughput<false>(1, true));
+
+	for (size_t producers : { 1, 2, 4 })
+		Bench::report("SharedFixedQueue<multi_producer> " + std::to_string(producers) + " producers, polling", sharedThroughput<true>(producers, false));
+
+	Bench::report("pipe, 256 elements per write", pipeThroughput());
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstdlib>
+#include <cstring>
+#include <algorithm>
 #include <vector>
 #include <tuple>
 #include <iostream>
@@ -89,8 +91,8 @@ namespace ADS
 
         size_t size() { return (size_t)(end - start); }
 
-        bool operator==(const MemBlockInfo& other) { return start == other.start && end == other.end; }
-        bool operator!=(const MemBlockInfo& other) { return !(*this == other); }
+        bool operator==(const MemBlockInfo& other) const { return start == other.start && end == other.end; }
+        bool operator!=(const MemBlockInfo& other) const { return !(*this == other); }
     };
 
     class ModArena;
@@ -203,6 +205,8 @@ namespace ADS
 
         // frees the passed address from the arena.
         void free(ArenaPtr<void> address);
+        // frees the memory block starting at the passed address, which must have been returned by alloc.
+        void free(void* address);
 
         // resizes the size of the memory arena to new_arena_size (in bytes).
         // pointers returned by alloc will still be usable if they are reset.
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <memory_resource>
+#include "Arena.h"
+
+namespace ADS
+{
+	/*
+	a std::pmr::memory_resource allocating from a StaticArena or a ModArena,
+	so an arena can back a pmr::FixedQueue, or any other container using a std::pmr::polymorphic_allocator.
+
+	neither arena aligns its memory blocks, so every block is padded to fit the requested alignment,
+	and the address of the block is stored right in front of the address returned by allocate.
+
+	the arena must outlive the resource and all memory allocated from it.
+	a ModArena must not be resized or defragmented while memory allocated from it is in use, as that moves the memory blocks.
+
+	throws std::bad_alloc if the arena does not have enough free memory.
+	*/
+	template<typename TArena>
+	class ArenaResource: public std::pmr::memory_resource
+	{
+	public:
+		ArenaResource(TArena& arena)
+			: m_arena(arena) {}
+
+		TArena& arena() const { return m_arena; }
+
+	protected:
+		void* do_allocate(size_t bytes, size_t alignment) override;
+		void do_deallocate(void* address, size_t bytes, size_t alignment) override;
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+		TArena& m_arena;
+	};
+}
+
+#include "ArenaResource.ipp"
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include "FixedQueue.h"
+
+namespace ADS
+{
+	/*
+	a fixed size queue shared between threads, where pushing to a full queue or popping from an empty queue blocks until the other side makes progress.
+
+	the elements are kept in a FixedQueue guarded by a mutex, which is only held to move elements in and out of it.
+	blocked threads sleep on two 32 bit counters instead of the mutex, one bumped by every push and one by every pop.
+	a thread about to sleep registers itself as a waiter and then sleeps only if the counter still has the value it saw before checking the queue,
+	so a push or pop in between is never missed, and pushes and pops only make a system call to wake a thread if one is waiting.
+
+	a push of n elements at once wakes up to n consumers, and a pop of n elements up to n producers.
+
+	on linux the threads sleep on a futex directly, which is what std::atomic::wait does, but with a timeout for the timed variants.
+	on other systems std::atomic::wait and notify are used, and the timed variants sleep for short intervals instead.
+
+	unlike FixedQueue, a full queue is never overwritten, see push_wait.
+	*/
+	template<typename T, typename TCapacity = ModCapacity>
+	class BlockingFixedQueue
+	{
+	public:
+		BlockingFixedQueue(size_t size)
+			: m_queue(size) {}
+
+		BlockingFixedQueue(const BlockingFixedQueue&) = delete;
+		BlockingFixedQueue& operator=(const BlockingFixedQueue&) = delete;
+
+		// pushes elem to the back of the queue, returns false if the queue is full.
+		bool try_push(const T& elem) { return pushUntil(elem, std::chrono::steady_clock::time_point::min()); }
+		bool try_push(T&& elem) { return pushUntil(std::move(elem), std::chrono::steady_clock::time_point::min()); }
+
+		// pushes elem to the back of the queue, waiting for an element to be popped if the queue is full.
+		void push_wait(const T& elem) { pushUntil(elem, std::chrono::steady_clock::time_point::max()); }
+		void push_wait(T&& elem) { pushUntil(std::move(elem), std::chrono::steady_clock::time_point::max()); }
+		// pushes all the elements of [begin, end), waiting for room whenever the queue is full.
+		// as many elements as fit are pushed under one lock, and the consumers are woken once for all of them.
+		template<Bases::i_iterator_ct<T> TIter>
+		void push_wait(TIter begin, TIter end);
+
+		// same as push_wait, but returns false if the queue stayed full for timeout.
+		bool push_wait_for(const T& elem, std::chrono::nanoseconds timeout) { return pushUntil(elem, std::chrono::steady_clock::now() + timeout); }
+		bool push_wait_for(T&& elem, std::chrono::nanoseconds timeout) { return pushUntil(std::move(elem), std::chrono::steady_clock::now() + timeout); }
+
+		// moves the front of the queue into target and pops it, returns false if the queue is empty.
+		bool try_pop(T& target) { return popUntil(&target, 1, std::chrono::steady_clock::time_point::min()); }
+
+		// moves the front of the queue into target and pops it, waiting for an element to be pushed if the queue is empty.
+		void pop_wait(T& target) { popUntil(&target, 1, std::chrono::steady_clock::time_point::max()); }
+		// waits until the queue is not empty, and then moves up to elem_count elements into target.
+		// returns the number of elements popped. returns 0 right away if elem_count is 0.
+		size_t pop_wait(T* target, size_t elem_count) { return popUntil(target, elem_count, std::chrono::steady_clock::time_point::max()); }
+
+		// same as pop_wait, but returns false / 0 if the queue stayed empty for timeout.
+		bool pop_wait_for(T& target, std::chrono::nanoseconds timeout) { return popUntil(&target, 1, std::chrono::steady_clock::now() + timeout); }
+		size_t pop_wait_for(T* target, size_t elem_count, std::chrono::nanoseconds timeout) { return popUntil(target, elem_count, std::chrono::steady_clock::now() + timeout); }
+
+		size_t size() const { return m_queue.size(); }
+		// the length is only a snapshot, as other threads may push or pop at any time.
+		size_t length() const;
+
+		bool full() const { return length() == size(); }
+		bool empty() const { return length() == 0; }
+
+	protected:
+		// pushes elem, waiting for room until deadline. a deadline in the past tries once.
+		template<typename TElem>
+		bool pushUntil(TElem&& elem, std::chrono::steady_clock::time_point deadline);
+		// pops up to elem_count elements into target, waiting for an element until deadline.
+		size_t popUntil(T* target, size_t elem_count, std::chrono::steady_clock::time_point deadline);
+
+		// bumps the push counter and wakes up to elem_count consumers, if any are waiting.
+		void notifyPushed(size_t elem_count);
+		// bumps the pop counter and wakes up to elem_count producers, if any are waiting.
+		void notifyPopped(size_t elem_count);
+
+		// sleeps until counter no longer equals seen, until deadline, or until a spurious wakeup.
+		static void waitChange(std::atomic<uint32_t>& counter, uint32_t seen, std::chrono::steady_clock::time_point deadline);
+		// wakes up to thread_count threads sleeping on counter.
+		static void wake(std::atomic<uint32_t>& counter, size_t thread_count);
+
+		static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) && std::atomic<uint32_t>::is_always_lock_free);
+
+		mutable std::mutex m_mutex;
+		FixedQueue<T, TCapacity> m_queue;
+
+		alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> m_push_count = 0;
+		std::atomic<uint32_t> m_pop_waiters = 0;
+
+		alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> m_pop_count = 0;
+		std::atomic<uint32_t> m_push_waiters = 0;
+	};
+}
+
+#include "BlockingFixedQueue.ipp"
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+#include "FixedQueue.h"
+
+namespace ADS
+{
+	namespace Bases
+	{
+		// the types CompressedFixedQueue can encode, integers of up to 64 bits and ieee floats.
+		template<typename T>
+		concept compressible_ct = (std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= sizeof(uint64_t))
+			|| std::is_same_v<T, float> || std::is_same_v<T, double>;
+	}
+
+	/*
+	a queue of numbers stored compressed, for long series of slowly changing values.
+
+	the elements are stored in blocks of block_size elements, and every block is encoded on its own,
+	so the front of the queue is evicted a whole block at a time and a block can be decoded without the blocks before it.
+	integers are encoded as the difference between consecutive deltas (delta of delta),
+	and floats as the xor with the previous value, storing only the bits between the leading and trailing zeros (like gorilla).
+	a series which changes at a steady rate or not at all takes about one bit per element.
+
+	BLOCK = FIRST + LENGTH + MIN + MAX + SUM + ENCODED BITS...
+
+	(BLOCK SIZE = 4, 3 BLOCKS)
+	 FRONT                      BACK
+	 |                          |
+	[1, 2, 3, 4][5, 6, 7, 8][9, 10] push 11, 12, 13
+	                                |
+	                                v
+	             FRONT                  BACK
+	             |                      |
+	[5, 6, 7, 8][9, 10, 11, 12][13]
+
+	the block ring holds one more block than size requires, so at least the last size elements are always kept,
+	and size() returns the largest number of elements the blocks can hold.
+
+	the elements can only be read in order through the iterators, which decode them as they go.
+	min, max and sum are kept per block, so avg, max and min only visit the blocks and not the elements.
+
+	the encoded bits of the back block grow as elements are pushed, and are shrunk to fit once the block is full,
+	so memory is allocated once or twice per block and not per element.
+	*/
+	template<Bases::compressible_ct T, size_t block_size = 1024>
+	class CompressedFixedQueue
+	{
+	public:
+		static_assert(block_size > 0, "block_size must not be 0");
+
+		// the type the sums of the blocks are kept as.
+		using sum_type = std::conditional_t<std::is_floating_point_v<T>, double, std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>>;
+
+		class Iterator;
+
+		CompressedFixedQueue(size_t size);
+
+		void push_back(T elem);
+		inline void push(T elem) { push_back(elem); }
+		void operator<<(T elem) { push_back(elem); }
+
+		// the queue must not be empty.
+		T front() const { return m_blocks.begin()->first; }
+		T back() const { return m_state.value; }
+
+		// evicts the front block, the queue must not be empty.
+		void popBlock();
+
+		size_t size() const { return m_blocks.size() * block_size; }
+		size_t length() const { return m_length; }
+		size_t blockCount() const { return m_blocks.length(); }
+
+		bool empty() const { return m_length == 0; }
+
+		// returns the avrage of all the elements, the sum of all the elements must fit in sum_type. the queue must not be empty.
+		T avg() const;
+		// the queue must not be empty.
+		T max() const;
+		T min() const;
+
+		// returns the number of bytes used by the blocks, including the encoded bits.
+		size_t compressedBytes() const;
+		// returns the number of bytes an uncompressed queue of the same elements uses, divided by compressedBytes.
+		double compressionRatio() const { return (double)(m_length * sizeof(T)) / compressedBytes(); }
+
+		void clear();
+
+		Iterator begin() const { return Iterator(m_blocks.begin(), m_length); }
+		Iterator end() const { return Iterator(); }
+
+	protected:
+		// the unsigned integer holding the bits of T.
+		using bits_type = std::conditional_t<sizeof(T) <= sizeof(uint32_t) && std::is_floating_point_v<T>, uint32_t, uint64_t>;
+		static constexpr int BITS = sizeof(bits_type) * 8;
+
+		struct Block
+		{
+			// the encoded elements after the first one, written from the lowest bit of each word.
+			std::vector<uint64_t> words;
+			size_t bit_count = 0;
+			size_t length = 0;
+
+			T first = 0;
+			T min = 0;
+			T max = 0;
+			sum_type sum = 0;
+		};
+
+		// the state shared by the encoder and the decoder, which is reset at the start of every block.
+		struct CodecState
+		{
+			T value = 0;
+			// the last delta, for integers.
+			uint64_t delta = 0;
+			// the leading and trailing zeros of the last stored xor, for floats.
+			int leading = BITS + 1;
+			int trailing = 0;
+		};
+
+		// integer sums wrap around instead of overflowing, so the total is still exact if it fits in sum_type even if a partial sum does not.
+		static sum_type addSum(sum_type sum, sum_type value);
+
+		static void writeBits(Block& block, uint64_t value, int bit_count);
+		static uint64_t readBits(const Block& block, size_t& bit_pos, int bit_count);
+
+		// appends elem to block, which must already hold an element.
+		static void encode(Block& block, T elem, CodecState& state);
+		// returns the element after state.value from block, and advances bit_pos past it.
+		static T decode(const Block& block, size_t& bit_pos, CodecState& state);
+
+		FixedQueue<Block> m_blocks;
+		size_t m_length = 0;
+
+		// the encoder state of the back block.
+		CodecState m_state;
+	};
+
+	// a forward iterator decoding the elements of a CompressedFixedQueue in order.
+	// the elements can not be modified, and the reference returned by operator* is only valid until the iterator is incremented.
+	template<Bases::compressible_ct T, size_t block_size>
+	class CompressedFixedQueue<T, block_size>::Iterator
+	{
+	public:
+		using difference_type = std::ptrdiff_t;
+		using value_type = T;
+		using pointer = const T*;
+		using reference = const T&;
+		using iterator_category = std::forward_iterator_tag;
+		using iterator_concept = std::forward_iterator_tag;
+
+		// the end iterator.
+		Iterator() = default;
+		// decodes remaining elements from the start of block.
+		Iterator(ConstFixedQueueIterator<Block> block, size_t remaining);
+
+		reference operator*() const { return m_state.value; }
+		pointer operator->() const { return &m_state.value; }
+
+		Iterator& operator++();
+		Iterator operator++(int);
+
+		// iterators are compared by the number of elements left, so only iterators of the same queue can be compared.
+		bool operator==(const Iterator& other) const { return m_remaining == other.m_remaining; }
+
+	protected:
+		// starts decoding the block m_block points to.
+		void loadBlock();
+
+		ConstFixedQueueIterator<Block> m_block;
+		size_t m_index = 0;
+		size_t m_bit_pos = 0;
+		CodecState m_state;
+
+		size_t m_remaining = 0;
+	};
+}
+
+#include "CompressedFixedQueue.ipp"
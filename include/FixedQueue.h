@@ -5,20 +5,63 @@
 #include <array>
 #include <concepts>
 #include <memory>
+#include <memory_resource>
+#include <bit>
+#include <span>
+#include <iterator>
+#include <cmath>
+#include <cassert>
+#include "FixedQueueTrackers.h"
+#include "FixedQueueOverflow.h"
+#include "FixedQueueSIMD.h"
 
 namespace ADS
 {
+	// capacity policies decide what capacity a FixedQueue ends up with, and how indices are wrapped around the end of its buffer.
+
+	// accepts any capacity, indices are wrapped with the modulo operator.
+	struct ModCapacity
+	{
+		static constexpr size_t capacity(size_t requested) { return requested; }
+		static constexpr size_t wrap(size_t index, size_t capacity) { return index % capacity; }
+	};
+
+	// rounds the capacity up to the nearest power of two, so indices can be wrapped with a bitmask instead of a division.
+	struct Pow2Capacity
+	{
+		static constexpr size_t capacity(size_t requested) { return std::bit_ceil(requested); }
+		static constexpr size_t wrap(size_t index, size_t capacity) { return index & (capacity - 1); }
+	};
+
+	// used by MirroredFixedQueue, where the buffer is mapped twice back to back in virtual memory.
+	// any logical index can be read directly from the front without wrapping, only the front index itself is wrapped.
+	struct MirroredCapacity
+	{
+		static constexpr bool mirrored = true;
+
+		// the capacity is rounded up to whole pages by MirroredFixedQueue itself.
+		static constexpr size_t capacity(size_t requested) { return requested; }
+		// index is always less than twice the capacity, so a subtraction is enough to wrap it.
+		static constexpr size_t wrap(size_t index, size_t capacity) { return index >= capacity ? index - capacity : index; }
+	};
+
+	// capacity policy used by SFixedQueue, picks Pow2Capacity if n is a power of two.
+	template<size_t n>
+	using StaticCapacity = std::conditional_t<std::has_single_bit(n), Pow2Capacity, ModCapacity>;
+
+	// used to keep data written by different threads on separate cache lines.
+	inline constexpr size_t CACHE_LINE_SIZE = 64;
 
 	template<typename T>
 	class FixedQueueIterator;
 	template<typename T>
-	class ConstFixedQueueIterator;
+	using ConstFixedQueueIterator = FixedQueueIterator<const T>;
 
 	namespace Bases
 	{
 
 		template<typename TIter, typename T>
-		concept i_iterator_ct = std::input_iterator<TIter> && std::is_convertible_v<typename TIter::value_type, T>;
+		concept i_iterator_ct = std::input_iterator<TIter> && std::is_convertible_v<std::iter_value_t<TIter>, T>;
 
 		/*
 		class for containing a fixed size queue
@@ -38,32 +81,63 @@ namespace ADS
 		[5, 2, 3, 4]
 
 		NO ELEMENTS ARE COPIED EXCEPT FOR THE PUSH ARGUMENT
+
+		only the slots from the front to the back hold constructed elements, the rest of m_data is uninitialized storage.
+		elements are constructed when they are pushed and destroyed when they are popped.
+
+		TCapacity = the capacity policy, see ModCapacity and Pow2Capacity.
+		size must already be a valid capacity for the policy.
+
+		TTracker = keeps aggregates of the elements up to date on every push and pop, see FixedQueueTrackers.h.
+
+		TOverflow = decides what a push to a full queue does, overwriting the front by default, see FixedQueueOverflow.h.
+
+		the owner of m_data is responsible for destroying the remaining elements, see destroyElements.
 		*/
-		template<typename T>
-		class FixedQueueBase
+		template<typename T, typename TCapacity = ModCapacity, typename TTracker = NoTracker, typename TOverflow = OverwriteOverflow>
+		class FixedQueueBase: public TTracker, public TOverflow
 		{
 		public:
+			// a pointer to the pushed element if TOverflow can drop it, which is nullptr if it was dropped, otherwise a reference to it.
+			using emplace_result = std::conditional_t<TOverflow::template rejects<T>, T*, T&>;
+
 			FixedQueueBase(T* data, size_t size)
-				: m_data(data), m_fixed_size(size) {}
+				: m_data(data), m_fixed_size(size)
+			{
+				assert(TCapacity::capacity(size) == size);
+				TTracker::onResize(size);
+			}
 
 			T& front() { return m_data[m_front_index]; }
 			T front() const { return m_data[m_front_index]; }
 
-			void push_back(T elem);
+			void push_back(const T& elem) { emplace_back(elem); }
+			void push_back(T&& elem) { emplace_back(std::move(elem)); }
+			// constructs the element from args at the back of the queue and returns it.
+			// if the queue is full, the front element is overwritten, unless TOverflow drops the element instead, see emplace_result.
+			template<typename... TArgs> requires std::is_constructible_v<T, TArgs...>
+			emplace_result emplace_back(TArgs&&... args);
+			// move_iterators are supported, the elements are moved into the queue instead of copied.
 			template<i_iterator_ct<T> TIter>
 			void push_back(TIter begin, TIter end);
 			template<typename TOther> requires std::is_convertible_v<TOther, T>
 			void push_back(std::initializer_list<TOther> list);
-			template<typename TOther> requires std::is_convertible_v<TOther, T>
-			void push_back(FixedQueueBase<TOther>& other);
-			template<typename TOther> requires std::is_convertible_v<TOther, T>
-			void push_back(const FixedQueueBase<TOther>& other);
+			template<typename TOther, typename... TOtherParams> requires std::is_convertible_v<TOther, T>
+			void push_back(FixedQueueBase<TOther, TOtherParams...>& other);
+			template<typename TOther, typename... TOtherParams> requires std::is_convertible_v<TOther, T>
+			void push_back(const FixedQueueBase<TOther, TOtherParams...>& other);
 			template<typename TOther>
 			void push_back(const std::vector<TOther>& vec) { push_back(vec.begin(), vec.end()); };
 			template<typename TOther, size_t n>
 			void push_back(const std::array<TOther, n>& arr) { push_back(arr.begin(), arr.end()); };
+			// the elements of the rvalue containers are moved into the queue.
+			template<typename TOther>
+			void push_back(std::vector<TOther>&& vec) { pushMoved(vec.begin(), vec.end()); };
+			template<typename TOther, size_t n>
+			void push_back(std::array<TOther, n>&& arr) { pushMoved(arr.begin(), arr.end()); };
 
-			inline void push(T elem) { push_back(elem); };
+			inline void push(const T& elem) { push_back(elem); };
+			inline void push(T&& elem) { push_back(std::move(elem)); };
 			template<i_iterator_ct<T> TIter>
 			inline void push(TIter begin, TIter end) { push_back(begin, end); };
 			template<typename TOther>
@@ -72,13 +146,32 @@ namespace ADS
 			inline void push(const std::vector<TOther>& vec) { push_back(vec); };
 			template<typename TOther, size_t n>
 			inline void push(const std::array<TOther, n>& arr) { push_back(arr); };
+			template<typename TOther>
+			inline void push(std::vector<TOther>&& vec) { push_back(std::move(vec)); };
+			template<typename TOther, size_t n>
+			inline void push(std::array<TOther, n>&& arr) { push_back(std::move(arr)); };
 
-			T& back() { return m_data[(m_front_index + m_size) % m_fixed_size]; }
-			T back() const { return m_data[(m_front_index + m_size) % m_fixed_size]; }
+			T& back() { return m_data[projectIndex(m_size - 1)]; }
+			T back() const { return m_data[projectIndex(m_size - 1)]; }
 
 			void pop_front(size_t elem_count = 1);
+			// moves the first elem_count elements into target before popping them.
+			void pop_front(T* target, size_t elem_count);
 			inline void pop(size_t elem_count = 1) { pop_front(elem_count); };
 
+			// returns up to elem_count free slots after the back of the queue, as the part before the end of the buffer and the part that wrapped around to the start of it.
+			// the slots can be written directly, for example by a decoder, and are pushed by publish. fewer slots are returned if the queue does not have elem_count free slots.
+			// the slots are uninitialized, so T must be trivially copyable.
+			std::pair<std::span<T>, std::span<T>> reserve(size_t elem_count) requires std::is_trivially_copyable_v<T>;
+			// pushes the first elem_count slots returned by reserve, which must have been written.
+			void publish(size_t elem_count) requires std::is_trivially_copyable_v<T>;
+
+			// returns up to elem_count elements from the front without copying them, see spans.
+			std::pair<std::span<T>, std::span<T>> peek(size_t elem_count);
+			std::pair<std::span<const T>, std::span<const T>> peek(size_t elem_count) const;
+			// pops elem_count elements after they have been read through peek.
+			inline void consume(size_t elem_count) { if (elem_count) pop_front(elem_count); };
+
 			size_t size() const { return m_fixed_size; };
 			size_t length() const { return m_size; };
 
@@ -88,12 +181,22 @@ namespace ADS
 			T& operator[](size_t index);
 			T operator[](size_t index) const;
 
+			// returns the elements of the queue from offset without copying them, as the part before the end of the buffer and the part that wrapped around to the start of it.
+			// the second span is empty if the elements do not wrap around.
+			std::pair<std::span<T>, std::span<T>> spans(size_t offset = 0);
+			std::pair<std::span<const T>, std::span<const T>> spans(size_t offset = 0) const;
+
+			// rotates the buffer in place so the front of the queue is at the start of it, and returns all the elements as a single span.
+			std::span<T> linearize();
+
 			template<typename TCast = T> requires std::is_convertible_v<T, TCast>
 			std::vector<TCast> toVector() const;
 			template<typename TCast = T> requires std::is_convertible_v<T, TCast>
 			std::unique_ptr<TCast> toCarr() const;
 
 			// returns the avrage of all the elements in the queue
+			// if TTracker keeps a sum of the elements, this is O(1).
+			// otherwise the sum is vectorized if T is an SIMD::simd_ct type and TAvg is T.
 			//
 			// TAvg = the data type of the variable that stores the avrage.
 			// should be large enough to contain the sum of all the elements.
@@ -102,49 +205,116 @@ namespace ADS
 			T avg();
 
 			// returns the avrage of all the elements in the queue using a less precise method, but has no size cap.
+			// if TTracker keeps a sum of the elements, the sum is used instead.
 			//
 			// TAvg = the data type that stores the avrage.
 			// a floating point data type is recommended since this method relies on dividing each element before adding them to the result
 			template<typename TAvg = float> requires requires(T x) { x + x / x; }
 			T avgHuge();
 
+			// returns the population variance of the elements in the queue.
+			// if TTracker tracks the moments of the elements, this is O(1).
+			//
+			// TFloat = the floating point data type used for the calculation.
+			template<typename TFloat = double>
+			TFloat variance() const;
+
+			// returns the population standard deviation of the elements in the queue, see variance.
+			template<typename TFloat = double>
+			TFloat stddev() const { return std::sqrt(variance<TFloat>()); }
+
+			// returns the q quantile (0 <= q <= 1) of the elements in the queue using the nearest rank method, the queue must not be empty.
+			// if TTracker keeps the elements in sorted order, this is O(log n), otherwise the elements are copied and partially sorted.
+			T quantile(double q) const;
+			// returns the 0.5 quantile.
+			T median() const { return quantile(0.5); }
+
 			// returns the maximum value inside the queue from offset.
+			// if TTracker tracks the maximum and offset is 0, this is O(1).
+			// otherwise the search is vectorized if T is an SIMD::simd_ct type, this also applies to min, iOfMax and iOfMin.
 			T max(size_t offset = 0);
-			// returns the index of the minimum value.
-			// if there are more than one instance of the minimum value, the first minimum value from offset found will be returned.
+			// returns the index of the maximum value.
+			// if there are more than one instance of the maximum value, the first maximum value from offset found will be returned.
 			size_t iOfMax(size_t offset = 0);
 
 			// returns the minimum value inside the queue from offset.
+			// if TTracker tracks the minimum and offset is 0, this is O(1).
 			T min(size_t offset = 0);
 			// returns the index of the minimum value.
-			// if there are more than one instance of the maximum value, the first maximum value from offset found will be returned.
+			// if there are more than one instance of the minimum value, the first minimum value from offset found will be returned.
 			size_t iOfMin(size_t offset = 0);
 
 
-			// sets size to 0 and puts front_index at the start of the m_data array
+			// destroys all elements, sets size to 0 and puts front_index at the start of the m_data array
 			void clear();
 
-			FixedQueueIterator<T> begin();
-			ConstFixedQueueIterator<T> begin() const;
+			FixedQueueIterator<T> begin() { return FixedQueueIterator<T>(m_data, m_fixed_size, m_front_index, 0); }
+			ConstFixedQueueIterator<T> begin() const { return ConstFixedQueueIterator<T>(m_data, m_fixed_size, m_front_index, 0); }
 
-			FixedQueueIterator<T> end();
-			ConstFixedQueueIterator<T> end() const;
+			FixedQueueIterator<T> end() { return FixedQueueIterator<T>(m_data, m_fixed_size, m_front_index, m_size); }
+			ConstFixedQueueIterator<T> end() const { return ConstFixedQueueIterator<T>(m_data, m_fixed_size, m_front_index, m_size); }
 
 			// pushes the element to the que
-			void operator<<(T elem) { push_back(elem); }
+			void operator<<(const T& elem) { push_back(elem); }
+			void operator<<(T&& elem) { push_back(std::move(elem)); }
 			template<typename TOther>
 			void operator<<(const std::vector<TOther>& vec) { push_back(vec); }
+			template<typename TOther>
+			void operator<<(std::vector<TOther>&& vec) { push_back(std::move(vec)); }
 			template<typename TOther, size_t n>
 			void operator<<(const std::array<TOther, n>& arr) { push_back(arr); }
-			template<typename TOther> requires std::is_convertible_v<TOther, T>
-			void operator<<(FixedQueueBase<TOther>& other) { push_back(other); }
-			template<typename TOther> requires std::is_convertible_v<TOther, T>
-			void operator<<(const FixedQueueBase<TOther>& other) { push_back(other); }
+			template<typename TOther, size_t n>
+			void operator<<(std::array<TOther, n>&& arr) { push_back(std::move(arr)); }
+			template<typename TOther, typename... TOtherParams> requires std::is_convertible_v<TOther, T>
+			void operator<<(FixedQueueBase<TOther, TOtherParams...>& other) { push_back(other); }
+			template<typename TOther, typename... TOtherParams> requires std::is_convertible_v<TOther, T>
+			void operator<<(const FixedQueueBase<TOther, TOtherParams...>& other) { push_back(other); }
 
 
 		protected:
+			// true if m_data is followed by a mirror of itself, see MirroredCapacity.
+			static constexpr bool is_mirrored = requires { requires TCapacity::mirrored; };
+
+			// true if TOverflow can handle the overflow of a bulk push at once, otherwise the elements are pushed one by one.
+			static constexpr bool bulk_overflow = requires(TOverflow& overflow) { overflow.onOverflowCount(size_t(0)); };
+
 			size_t projectIndex(size_t index) const;
 
+			// returns the number of slots that can be accessed contiguously from the passed index into m_data.
+			size_t contiguousFrom(size_t data_index) const { return is_mirrored ? m_fixed_size : m_fixed_size - data_index; }
+
+			// applies reduce to both segments of the queue from offset, and then to the two results.
+			// reduce(const T* data, size_t count) must return T, and the queue must have elements after offset.
+			template<typename TReduce>
+			T reduceSegments(size_t offset, TReduce reduce) const;
+
+			// returns the index of the first element from offset equal to value, or SIZE_MAX if there is none.
+			size_t findFrom(size_t offset, const T& value) const;
+
+			// destroys the first elem_count elements and advances the front past them, without notifying the tracker.
+			void dropFront(size_t elem_count);
+
+			// destroys all elements without notifying the tracker, the size and front index are left as is.
+			void destroyElements();
+
+			// constructs copies of the elements of other from the start of m_data, and copies its tracker state and overflow counters.
+			// the queue must be empty and large enough to hold the elements.
+			void copyElements(const FixedQueueBase& other);
+			// same as copyElements, but the elements and tracker state are moved and other is cleared.
+			void moveElements(FixedQueueBase& other);
+
+			// pushes the elements of [begin, end) by moving them, or by copying them if that is cheaper.
+			template<typename TIter>
+			void pushMoved(TIter begin, TIter end);
+
+			// notifies the tracker of all the elements currently in the queue, should be called after the elements have been moved around.
+			void retrack();
+
+			// pushes count elements from src with at most two memcpy calls, one on each side of the wrap point.
+			// if count is larger than the queue size, only the last m_fixed_size elements are copied.
+			// only used if TOverflow handles overflows in bulk, a rejecting policy only copies the elements which fit.
+			void pushContiguous(const T* src, size_t count) requires std::is_trivially_copyable_v<T>;
+
 			size_t m_fixed_size;
 			size_t m_size = 0;
 
@@ -155,127 +325,168 @@ namespace ADS
 	}
 
 	
-	template<typename T>
-	class FixedQueue: public Bases::FixedQueueBase<T>
+	// the passed size is passed through TCapacity::capacity, so FixedQueue<T, Pow2Capacity> rounds it up to the nearest power of two.
+	// the storage is allocated uninitialized, so T does not have to be default constructible and construction does not depend on the size.
+	// TAlloc = the allocator the storage is allocated with, it follows the propagation rules of the standard containers.
+	// TOverflow = the overflow policy, see FixedQueueOverflow.h.
+	template<typename T, typename TCapacity = ModCapacity, typename TTracker = NoTracker, typename TAlloc = std::allocator<T>, typename TOverflow = OverwriteOverflow>
+	class FixedQueue: public Bases::FixedQueueBase<T, TCapacity, TTracker, TOverflow>
 	{
+		static_assert(std::is_same_v<typename std::allocator_traits<TAlloc>::value_type, T>, "the value type of TAlloc must be T");
+
+		using alloc_traits = std::allocator_traits<TAlloc>;
+
 	public:
-		FixedQueue(size_t size = 0);
+		FixedQueue(size_t size = 0, const TAlloc& alloc = TAlloc());
+		~FixedQueue();
+
+		FixedQueue(const FixedQueue& other);
+		// takes over the storage of other, which is left empty with a size of 0.
+		FixedQueue(FixedQueue&& other) noexcept;
+		FixedQueue& operator=(const FixedQueue& other);
+		// if the allocator does not propagate and is not equal to the allocator of other, the elements are moved one by one into storage from this queues allocator.
+		FixedQueue& operator=(FixedQueue&& other) noexcept(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value);
 
 		void resize(size_t new_size);
 
+		TAlloc get_allocator() const { return m_alloc; }
+
 	protected:
+		// allocates uninitialized storage for size elements.
+		T* allocate(size_t size);
+		void deallocate(T* data, size_t size);
 
-		using Bases::FixedQueueBase<T>::m_data;
-		using Bases::FixedQueueBase<T>::m_fixed_size;
-		using Bases::FixedQueueBase<T>::m_size;
-		using Bases::FixedQueueBase<T>::m_front_index;
+		// leaves the queue without storage after it has been moved from.
+		void release();
+
+		[[no_unique_address]] TAlloc m_alloc;
+
+		using Bases::FixedQueueBase<T, TCapacity, TTracker, TOverflow>::m_data;
+		using Bases::FixedQueueBase<T, TCapacity, TTracker, TOverflow>::m_fixed_size;
+		using Bases::FixedQueueBase<T, TCapacity, TTracker, TOverflow>::m_size;
+		using Bases::FixedQueueBase<T, TCapacity, TTracker, TOverflow>::m_front_index;
 	};
 
+	namespace pmr
+	{
+		// a FixedQueue allocating its storage from a std::pmr::memory_resource, see ArenaResource for a resource allocating from an arena.
+		template<typename T, typename TCapacity = ModCapacity, typename TTracker = NoTracker, typename TOverflow = OverwriteOverflow>
+		using FixedQueue = ADS::FixedQueue<T, TCapacity, TTracker, std::pmr::polymorphic_allocator<T>, TOverflow>;
+	}
+
 	// a static version of FixedQueue
-	template<typename T, size_t n>
-	class SFixedQueue: public Bases::FixedQueueBase<T>
+	// if n is a power of two, indices are wrapped with a bitmask instead of a division.
+	template<typename T, size_t n, typename TTracker = NoTracker, typename TOverflow = OverwriteOverflow>
+	class SFixedQueue: public Bases::FixedQueueBase<T, StaticCapacity<n>, TTracker, TOverflow>
 	{
 	public:
 		SFixedQueue()
-			: Bases::FixedQueueBase<T>(m_data, n) {};
+			: Bases::FixedQueueBase<T, StaticCapacity<n>, TTracker, TOverflow>(reinterpret_cast<T*>(m_storage), n) {};
+		~SFixedQueue() { this->destroyElements(); }
+
+		// the storage is part of the object, so copying and moving is done element by element.
+		SFixedQueue(const SFixedQueue& other)
+			: SFixedQueue() { this->copyElements(other); }
+		SFixedQueue(SFixedQueue&& other)
+			: SFixedQueue() { this->moveElements(other); }
+		SFixedQueue& operator=(const SFixedQueue& other);
+		SFixedQueue& operator=(SFixedQueue&& other);
 
 	protected:
 
-		T m_data[n];
+		// uninitialized storage for the elements, see FixedQueueBase.
+		alignas(T) unsigned char m_storage[n * sizeof(T)];
 	};
 
-	// Iterator for the FixedQueue class
+	/*
+	random access iterator for the FixedQueue class, T is const for the const iterator.
+
+	the iterator stores the logical index of the element it points to, so begin() and end() are different for a full queue,
+	and the distance between two iterators is the difference of their indices.
+	the index is converted to an index into m_data on every access.
+	*/
 	template<typename T>
 	class FixedQueueIterator
 	{
 	public:
 		using difference_type = std::ptrdiff_t;
-		using value_type = T;
+		using value_type = std::remove_cv_t<T>;
 		using pointer = T*;
 		using reference = T&;
 		using iterator_category = std::random_access_iterator_tag;
+		using iterator_concept = std::random_access_iterator_tag;
 
-		FixedQueueIterator(pointer ptr, const pointer q_front, const pointer q_back)
-			: m_ptr(ptr), m_q_front(q_front), m_q_back(q_back) {}
+		FixedQueueIterator() = default;
+		// front_index is the index into data of the front of the queue, and index is the index of the element from the front.
+		FixedQueueIterator(pointer data, size_t capacity, size_t front_index, difference_type index)
+			: m_data(data), m_capacity(capacity), m_front_index(front_index), m_index(index) {}
 
-		FixedQueueIterator& operator++();
-		FixedQueueIterator operator++(int);
+		// an iterator converts to a const iterator.
+		template<typename TOther> requires std::is_same_v<const TOther, T>
+		FixedQueueIterator(const FixedQueueIterator<TOther>& other)
+			: m_data(other.m_data), m_capacity(other.m_capacity), m_front_index(other.m_front_index), m_index(other.m_index) {}
 
-		FixedQueueIterator operator+(size_t offset);
-		FixedQueueIterator& operator+=(size_t offset);
-
-		FixedQueueIterator operator-(size_t offset);
-		FixedQueueIterator& operator-=(size_t offset);
+		reference operator*() const;
+		pointer operator->() const { return &**this; }
+		reference operator[](difference_type offset) const;
 
+		FixedQueueIterator& operator++();
+		FixedQueueIterator operator++(int);
 		FixedQueueIterator& operator--();
 		FixedQueueIterator operator--(int);
 
-		bool operator==(const FixedQueueIterator<T>& other) const;
-		bool operator!=(const FixedQueueIterator<T>& other) const;
-
-		reference operator*();
-
-	protected:
-		pointer m_ptr;
-		// stores the front and back of the m_data array, not the queue itself
-		const pointer m_q_front;
-		const pointer m_q_back;
-		bool past_self = false;
-	};
-
-	// Const Iterator for the Fixed Queue class
-	template<typename T>
-	class ConstFixedQueueIterator
-	{
-	public:
-		using difference_type = std::ptrdiff_t;
-		using value_type = const T;
-		using pointer = const T*;
-		using reference = const T&;
-		using iterator_category = std::random_access_iterator_tag;
-
-		ConstFixedQueueIterator(pointer ptr, const pointer q_front, const pointer q_back)
-			: m_ptr(ptr), m_q_front(q_front), m_q_back(q_back) {}
-
-		ConstFixedQueueIterator& operator++();
-		ConstFixedQueueIterator operator++(int);
+		FixedQueueIterator& operator+=(difference_type offset);
+		FixedQueueIterator& operator-=(difference_type offset);
 
-		ConstFixedQueueIterator operator+(size_t offset);
-		ConstFixedQueueIterator& operator+=(size_t offset);
+		friend FixedQueueIterator operator+(FixedQueueIterator it, difference_type offset) { return it += offset; }
+		friend FixedQueueIterator operator+(difference_type offset, FixedQueueIterator it) { return it += offset; }
+		friend FixedQueueIterator operator-(FixedQueueIterator it, difference_type offset) { return it -= offset; }
+		friend difference_type operator-(const FixedQueueIterator& lhs, const FixedQueueIterator& rhs) { return lhs.m_index - rhs.m_index; }
 
-		ConstFixedQueueIterator operator-(size_t offset);
-		ConstFixedQueueIterator& operator-=(size_t offset);
+		// only iterators of the same queue can be compared.
+		bool operator==(const FixedQueueIterator& other) const { return m_index == other.m_index; }
+		auto operator<=>(const FixedQueueIterator& other) const { return m_index <=> other.m_index; }
 
-		ConstFixedQueueIterator& operator--();
-		ConstFixedQueueIterator operator--(int);
+		// returns the contiguous parts of the buffer from this iterator to last, the second part is empty if the elements do not wrap around.
+		// see FixedQueueAlgorithms.h for algorithms running on the parts instead of the iterators.
+		std::pair<std::span<T>, std::span<T>> segments(const FixedQueueIterator& last) const;
 
-		bool operator==(const ConstFixedQueueIterator<T>& other) const;
-		bool operator!=(const ConstFixedQueueIterator<T>& other) const;
+	protected:
+		template<typename TOther>
+		friend class FixedQueueIterator;
 
-		reference operator*() const;
+		size_t dataIndex() const;
 
-	protected:
-		pointer m_ptr;
-		// stores the front and back of the m_data array, not the queue itself
-		const pointer m_q_front;
-		const pointer m_q_back;
-		bool past_self = false;
+		pointer m_data = nullptr;
+		size_t m_capacity = 0;
+		size_t m_front_index = 0;
+		difference_type m_index = 0;
 	};
+
+	namespace Bases
+	{
+		template<typename TQueue>
+		concept fixed_queue_ct = requires(TQueue& queue) { []<typename... TParams>(const FixedQueueBase<TParams...>&) {}(queue); };
+	}
 }
 
+// size() returns the capacity of the queue and not the number of elements, so std::ranges::size has to use end() - begin() instead.
+template<typename TQueue> requires ADS::Bases::fixed_queue_ct<TQueue>
+inline constexpr bool std::ranges::disable_sized_range<TQueue> = true;
+
 // stores the front into target and pops the que
-template<typename T, typename TVar> requires (!std::is_same_v<std::ostream, TVar>)
-void operator<<(TVar& target, ADS::Bases::FixedQueueBase<T>& que);
+template<typename T, typename TVar, typename... TParams> requires (!std::is_same_v<std::ostream, TVar>)
+void operator<<(TVar& target, ADS::Bases::FixedQueueBase<T, TParams...>& que);
 
 
-template<typename T, typename TVec>
-void operator<<(std::vector<TVec>& target, ADS::Bases::FixedQueueBase<T>& que);
+template<typename T, typename TVec, typename... TParams>
+void operator<<(std::vector<TVec>& target, ADS::Bases::FixedQueueBase<T, TParams...>& que);
 
-template<typename T, typename TVec, size_t n>
-void operator<<(std::array<TVec, n>& target, ADS::Bases::FixedQueueBase<T>& que);
+template<typename T, typename TVec, size_t n, typename... TParams>
+void operator<<(std::array<TVec, n>& target, ADS::Bases::FixedQueueBase<T, TParams...>& que);
 
-template<typename T>
-std::ostream& operator<<(std::ostream& stream, const ADS::Bases::FixedQueueBase<T>& queue);
+template<typename T, typename... TParams>
+std::ostream& operator<<(std::ostream& stream, const ADS::Bases::FixedQueueBase<T, TParams...>& queue);
 
 #include "FixedQueue.ipp"
 
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <functional>
+#include "FixedQueue.h"
+
+namespace ADS
+{
+	/*
+	versions of the standard algorithms for FixedQueue iterators.
+
+	the range between the iterators is split into the at most two contiguous parts of the buffer, see FixedQueueIterator::segments,
+	and the standard algorithm is run on each part with plain pointers.
+	this removes the wrap check from every step, so the inner loops can be vectorized.
+
+	every algorithm also has an overload taking the whole queue.
+	*/
+
+	// applies func to every element, and returns func.
+	template<typename T, typename TFunc>
+	TFunc for_each(FixedQueueIterator<T> first, FixedQueueIterator<T> last, TFunc func);
+
+	// copies the elements to out, and returns the iterator past the last element written.
+	template<typename T, typename TOutIter>
+	TOutIter copy(FixedQueueIterator<T> first, FixedQueueIterator<T> last, TOutIter out);
+
+	// assigns value to every element.
+	template<typename T, typename TValue>
+	void fill(FixedQueueIterator<T> first, FixedQueueIterator<T> last, const TValue& value);
+
+	// writes op(element) to out for every element, and returns the iterator past the last element written.
+	template<typename T, typename TOutIter, typename TOp>
+	TOutIter transform(FixedQueueIterator<T> first, FixedQueueIterator<T> last, TOutIter out, TOp op);
+
+	// folds the elements into init from front to back with op.
+	template<typename T, typename TInit, typename TOp = std::plus<>>
+	TInit accumulate(FixedQueueIterator<T> first, FixedQueueIterator<T> last, TInit init, TOp op = TOp());
+
+	// returns an iterator to the first element equal to value, or last if there is none.
+	template<typename T, typename TValue>
+	FixedQueueIterator<T> find(FixedQueueIterator<T> first, FixedQueueIterator<T> last, const TValue& value);
+
+	// returns the number of elements equal to value.
+	template<typename T, typename TValue>
+	std::ptrdiff_t count(FixedQueueIterator<T> first, FixedQueueIterator<T> last, const TValue& value);
+
+
+	template<Bases::fixed_queue_ct TQueue, typename TFunc>
+	TFunc for_each(TQueue& queue, TFunc func) { return for_each(queue.begin(), queue.end(), std::move(func)); }
+
+	template<Bases::fixed_queue_ct TQueue, typename TOutIter>
+	TOutIter copy(const TQueue& queue, TOutIter out) { return copy(queue.begin(), queue.end(), out); }
+
+	template<Bases::fixed_queue_ct TQueue, typename TValue>
+	void fill(TQueue& queue, const TValue& value) { fill(queue.begin(), queue.end(), value); }
+
+	template<Bases::fixed_queue_ct TQueue, typename TOutIter, typename TOp>
+	TOutIter transform(const TQueue& queue, TOutIter out, TOp op) { return transform(queue.begin(), queue.end(), out, std::move(op)); }
+
+	template<Bases::fixed_queue_ct TQueue, typename TInit, typename TOp = std::plus<>>
+	TInit accumulate(const TQueue& queue, TInit init, TOp op = TOp()) { return accumulate(queue.begin(), queue.end(), std::move(init), std::move(op)); }
+
+	template<Bases::fixed_queue_ct TQueue, typename TValue>
+	auto find(TQueue& queue, const TValue& value) { return find(queue.begin(), queue.end(), value); }
+
+	template<Bases::fixed_queue_ct TQueue, typename TValue>
+	std::ptrdiff_t count(const TQueue& queue, const TValue& value) { return count(queue.begin(), queue.end(), value); }
+}
+
+#include "FixedQueueAlgorithms.ipp"
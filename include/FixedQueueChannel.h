@@ -0,0 +1,139 @@
+#pragma once
+
+#include <coroutine>
+#include <optional>
+#include <utility>
+#include "FixedQueue.h"
+
+namespace ADS
+{
+	/*
+	a fixed size queue for passing elements between coroutines, where pushing to a full queue or popping from an empty queue suspends the coroutine.
+
+		co_await channel.push(elem);				// returns false if the channel is closed.
+		std::optional<T> elem = co_await channel.pop();	// returns std::nullopt once the channel is closed and empty.
+
+	the elements are kept in a FixedQueue, and a suspended coroutine waits in a list of the awaiters themselves,
+	which live in the frame of the coroutine, so no memory is allocated per push or pop.
+
+	a push or pop that unblocks a waiting coroutine resumes it right away on the current thread, before the push or pop returns.
+	a popping coroutine which is waiting is handed the element directly, without it going through the queue.
+	waiting coroutines are resumed in the order they started waiting.
+
+	the channel is not thread safe, all coroutines using it must run on the same thread or be synchronized externally,
+	and it must not be destroyed while coroutines are waiting on it, see close.
+	*/
+	template<typename T, typename TCapacity = ModCapacity>
+	class FixedQueueChannel
+	{
+	public:
+		class PushAwaiter;
+		class PopAwaiter;
+
+		FixedQueueChannel(size_t size)
+			: m_queue(size) {}
+
+		FixedQueueChannel(const FixedQueueChannel&) = delete;
+		FixedQueueChannel& operator=(const FixedQueueChannel&) = delete;
+
+		// co_await suspends until elem is pushed, and returns false if the channel is closed.
+		[[nodiscard]] PushAwaiter push(T elem) { return PushAwaiter(*this, std::move(elem)); }
+		// co_await suspends until an element is popped and returns it, or returns std::nullopt if the channel is closed and empty.
+		[[nodiscard]] PopAwaiter pop() { return PopAwaiter(*this); }
+
+		// pushes elem without suspending, returns false if the channel is full or closed.
+		bool try_push(T elem) { return pushFrom(elem); }
+		// pops an element into target without suspending, returns false if the channel is empty.
+		bool try_pop(T& target);
+
+		// resumes all waiting coroutines, pushes fail from then on, and pops fail once the remaining elements are popped.
+		void close();
+		bool closed() const { return m_closed; }
+
+		size_t size() const { return m_queue.size(); }
+		size_t length() const { return m_queue.length(); }
+
+		bool full() const { return length() == size(); }
+		bool empty() const { return length() == 0; }
+
+	protected:
+		// a first in first out list of waiting awaiters, linked through their m_next.
+		template<typename TAwaiter>
+		struct WaitList
+		{
+			TAwaiter* front = nullptr;
+			TAwaiter* back = nullptr;
+
+			bool empty() const { return front == nullptr; }
+			void push(TAwaiter* awaiter);
+			TAwaiter* pop();
+		};
+
+		// pushes elem or hands it to a waiting pop, elem is only moved from if this returns true.
+		bool pushFrom(T& elem);
+		// pops an element into target, which is left empty if there is none.
+		void popInto(std::optional<T>& target);
+
+		// pushes the element of the first waiting push into the queue and resumes it, if there is one.
+		void admitWaitingPush();
+
+		FixedQueue<T, TCapacity> m_queue;
+		bool m_closed = false;
+
+		WaitList<PushAwaiter> m_push_waiters;
+		WaitList<PopAwaiter> m_pop_waiters;
+	};
+
+	template<typename T, typename TCapacity>
+	class FixedQueueChannel<T, TCapacity>::PushAwaiter
+	{
+	public:
+		PushAwaiter(FixedQueueChannel& channel, T&& elem)
+			: m_channel(channel), m_elem(std::move(elem)) {}
+
+		// the awaiter is linked into the wait list by address, so it must not be copied or moved.
+		PushAwaiter(const PushAwaiter&) = delete;
+		PushAwaiter& operator=(const PushAwaiter&) = delete;
+
+		bool await_ready();
+		void await_suspend(std::coroutine_handle<> handle);
+		bool await_resume() const { return m_pushed; }
+
+	protected:
+		friend class FixedQueueChannel;
+
+		FixedQueueChannel& m_channel;
+		T m_elem;
+		bool m_pushed = false;
+
+		std::coroutine_handle<> m_handle;
+		PushAwaiter* m_next = nullptr;
+	};
+
+	template<typename T, typename TCapacity>
+	class FixedQueueChannel<T, TCapacity>::PopAwaiter
+	{
+	public:
+		PopAwaiter(FixedQueueChannel& channel)
+			: m_channel(channel) {}
+
+		// the awaiter is linked into the wait list by address, so it must not be copied or moved.
+		PopAwaiter(const PopAwaiter&) = delete;
+		PopAwaiter& operator=(const PopAwaiter&) = delete;
+
+		bool await_ready();
+		void await_suspend(std::coroutine_handle<> handle);
+		std::optional<T> await_resume() { return std::move(m_elem); }
+
+	protected:
+		friend class FixedQueueChannel;
+
+		FixedQueueChannel& m_channel;
+		std::optional<T> m_elem;
+
+		std::coroutine_handle<> m_handle;
+		PopAwaiter* m_next = nullptr;
+	};
+}
+
+#include "FixedQueueChannel.ipp"
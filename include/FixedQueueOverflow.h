@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace ADS
+{
+	/*
+	overflow policies decide what happens when an element is pushed to a full FixedQueue.
+
+	a policy is passed as the TOverflow template argument of FixedQueue / SFixedQueue, which then inherits from it like from TTracker,
+	so the counters of the policy can be read directly on the queue.
+
+	the queue calls the following protected hooks:
+		onOverflow(oldest)			an element is pushed to the full queue, oldest is the front which it would overwrite.
+									returns true to overwrite oldest, or false to drop the pushed element instead.
+									if rejects<T> is false, the tracker has already popped oldest, so it may be moved from.
+									otherwise oldest is const, as it stays in the queue if the push is dropped.
+		onOverflowCount(count)		count elements of a bulk push did not fit into the queue, and were handled in one go.
+									policies without this hook are called with onOverflow for every element instead.
+
+	rejects<T> is true if onOverflow can return false, in that case emplace_back returns a pointer which is nullptr if the element was dropped.
+	the hooks of OverwriteOverflow are empty and return constants, so the default costs nothing over a queue without policies.
+
+	a blocking policy is not provided, as nothing could pop from the queue while the pushing thread waits, see BlockingFixedQueue instead.
+	*/
+
+	namespace Bases
+	{
+		// a counter which can be read from any thread while the thread owning the queue updates it, without locking.
+		// only the owning thread adds to it, so a load and a store are enough, which is cheaper than fetch_add.
+		class OverflowCounter
+		{
+		public:
+			OverflowCounter() = default;
+			// copied along with the queue, atomics are not copyable on their own.
+			OverflowCounter(const OverflowCounter& other)
+				: m_count(other.value()) {}
+			OverflowCounter& operator=(const OverflowCounter& other) { m_count.store(other.value(), std::memory_order_relaxed); return *this; }
+
+			size_t value() const { return m_count.load(std::memory_order_relaxed); }
+			void add(size_t count) { m_count.store(m_count.load(std::memory_order_relaxed) + count, std::memory_order_relaxed); }
+
+		protected:
+			std::atomic<size_t> m_count = 0;
+		};
+	}
+
+	// the default policy, the pushed element overwrites the front. nothing is counted.
+	class OverwriteOverflow
+	{
+	public:
+		template<typename T>
+		static constexpr bool rejects = false;
+
+	protected:
+		template<typename T>
+		static constexpr bool onOverflow(const T&) { return true; }
+		static constexpr void onOverflowCount(size_t) {}
+	};
+
+	// same as OverwriteOverflow, but counts the overwritten elements.
+	class CountOverwriteOverflow
+	{
+	public:
+		template<typename T>
+		static constexpr bool rejects = false;
+
+		size_t overwritten() const { return m_overwritten.value(); }
+
+	protected:
+		template<typename T>
+		bool onOverflow(const T&) { m_overwritten.add(1); return true; }
+		void onOverflowCount(size_t count) { m_overwritten.add(count); }
+
+		Bases::OverflowCounter m_overwritten;
+	};
+
+	// the pushed element is dropped and the queue is left as is, the dropped elements are counted.
+	class RejectOverflow
+	{
+	public:
+		template<typename T>
+		static constexpr bool rejects = true;
+
+		size_t rejected() const { return m_rejected.value(); }
+
+	protected:
+		template<typename T>
+		bool onOverflow(const T&) { m_rejected.add(1); return false; }
+		void onOverflowCount(size_t count) { m_rejected.add(count); }
+
+		Bases::OverflowCounter m_rejected;
+	};
+
+	// calls TCallback with the front before a push overwrites it, for example to spill it somewhere else.
+	// the front is passed as a non const reference, so it may be moved from.
+	// if TCallback returns bool, returning false drops the pushed element and keeps the front instead,
+	// so the front is passed as a const reference, and TCallback has to accept one.
+	//
+	// TCallback = a default constructible callable, like the type of a lambda without captures.
+	// CallbackOverflow<decltype([](Sample& oldest) { spill(oldest); })>
+	template<typename TCallback>
+	class CallbackOverflow
+	{
+	public:
+		template<typename T>
+		static constexpr bool rejects = std::is_same_v<std::invoke_result_t<TCallback&, T&>, bool>;
+
+		size_t overwritten() const { return m_overwritten.value(); }
+		size_t rejected() const { return m_rejected.value(); }
+
+	protected:
+		template<typename T>
+		bool onOverflow(T& oldest)
+		{
+			if constexpr (rejects<std::remove_const_t<T>>)
+			{
+				static_assert(std::is_invocable_v<TCallback&, const T&>, "a CallbackOverflow callback returning bool has to take the front as a const reference");
+
+				if (!m_callback(std::as_const(oldest)))
+				{
+					m_rejected.add(1);
+					return false;
+				}
+			}
+			else
+				m_callback(oldest);
+
+			m_overwritten.add(1);
+			return true;
+		}
+
+		[[no_unique_address]] TCallback m_callback;
+
+		Bases::OverflowCounter m_overwritten;
+		Bases::OverflowCounter m_rejected;
+	};
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <thread>
+#include <vector>
+#include "FixedQueue.h"
+
+namespace ADS
+{
+	/*
+	multithreaded versions of the FixedQueue aggregates, for queues with millions of elements.
+
+	the range is split into one chunk of consecutive elements per thread, and every chunk is reduced on its contiguous parts of the buffer,
+	see FixedQueueIterator::segments. the chunk results are then combined in order on the calling thread.
+	chunk 0 runs on the calling thread, and a new thread is started for each of the other chunks.
+
+	thread_count = the maximum number of threads to use, 0 uses std::thread::hardware_concurrency.
+	fewer threads are used if the chunks would be smaller than MIN_CHUNK_SIZE elements.
+
+	the queue must not be modified while any of these functions run, and the passed operations must not throw.
+	*/
+	namespace Parallel
+	{
+		// the smallest number of elements a thread is started for.
+		inline constexpr size_t MIN_CHUNK_SIZE = size_t(1) << 15;
+
+		template<typename TQueue>
+		using queue_value_t = std::iter_value_t<decltype(std::declval<const TQueue&>().begin())>;
+
+		// reduces the elements into init with op, which must be associative and commutative like for std::reduce.
+		template<typename T, typename TInit, typename TOp>
+		TInit reduce(FixedQueueIterator<T> first, FixedQueueIterator<T> last, TInit init, TOp op, size_t thread_count = 0);
+
+		// writes op(element) to out for every element, and returns the iterator past the last element written.
+		template<typename T, std::random_access_iterator TOutIter, typename TOp>
+		TOutIter transform(FixedQueueIterator<T> first, FixedQueueIterator<T> last, TOutIter out, TOp op, size_t thread_count = 0);
+
+		// returns the avrage of the elements, see FixedQueueBase::avg, the queue must not be empty.
+		// TAvg = the data type of the sum, T if void.
+		template<typename TAvg = void, Bases::fixed_queue_ct TQueue>
+		queue_value_t<TQueue> avg(const TQueue& queue, size_t thread_count = 0);
+
+		// returns the maximum / minimum element, the queue must not be empty.
+		// the results are unspecified if the queue contains NaN.
+		template<Bases::fixed_queue_ct TQueue>
+		queue_value_t<TQueue> max(const TQueue& queue, size_t thread_count = 0);
+		template<Bases::fixed_queue_ct TQueue>
+		queue_value_t<TQueue> min(const TQueue& queue, size_t thread_count = 0);
+
+		// returns the index of the first maximum / minimum element, the queue must not be empty.
+		template<Bases::fixed_queue_ct TQueue>
+		size_t iOfMax(const TQueue& queue, size_t thread_count = 0);
+		template<Bases::fixed_queue_ct TQueue>
+		size_t iOfMin(const TQueue& queue, size_t thread_count = 0);
+	}
+}
+
+#include "FixedQueueParallel.ipp"
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <concepts>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define ADS_SIMD_X86
+#endif
+
+namespace ADS
+{
+	namespace SIMD
+	{
+		// element types which have vectorized kernels.
+		template<typename T>
+		concept simd_ct = std::same_as<T, int32_t> || std::same_as<T, int64_t> || std::same_as<T, float> || std::same_as<T, double>;
+
+		enum class InstructionSet
+		{
+			Scalar,
+			SSE2,
+			AVX2,
+			AVX512
+		};
+
+		// returns the widest instruction set supported by the cpu, it is only detected on the first call.
+		InstructionSet instructionSet();
+
+		// reductions over count contiguous elements, using the instruction set returned by instructionSet().
+		// count must be at least 1 for max and min.
+		//
+		// the elements are not reduced in order, so floating point sums may differ slightly from a sequential loop,
+		// and the result of max / min is unspecified if the range contains NaN.
+		template<simd_ct T>
+		T max(const T* data, size_t count);
+		template<simd_ct T>
+		T min(const T* data, size_t count);
+		template<simd_ct T>
+		T sum(const T* data, size_t count);
+	}
+}
+
+#include "FixedQueueSIMD.ipp"
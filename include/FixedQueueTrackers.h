@@ -0,0 +1,609 @@
+#pragma once
+
+#include <cstddef>
+#include <cassert>
+#include <cmath>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <cstdint>
+
+namespace ADS
+{
+	/*
+	trackers keep aggregates of the elements in a FixedQueue up to date as elements enter and leave it,
+	so the aggregate can be read in O(1) instead of scanning the queue.
+
+	a tracker is passed as the TTracker template argument of FixedQueue / SFixedQueue, which then inherits from it,
+	so the public members of the tracker can be accessed directly on the queue.
+
+	the queue calls the following protected hooks:
+		onPush(elem)		elem has been pushed to the back of the queue.
+		onPop(elem)			elem is about to be popped from the front of the queue, either by pop_front or by being overwritten.
+		onClear()			the queue has been cleared.
+		onResize(size)		the size of the queue has changed, also called on construction.
+
+	elements modified in place, through references returned by the queue, are not tracked.
+	*/
+
+	// combines multiple trackers into one, so a queue can track several aggregates at once.
+	// Trackers<SumTracker<long>, MinMaxTracker<int>>
+	template<typename... TTrackers>
+	class Trackers: public TTrackers...
+	{
+	protected:
+		template<typename T>
+		void onPush(const T& elem) { (TTrackers::onPush(elem), ...); }
+		template<typename T>
+		void onPop(const T& elem) { (TTrackers::onPop(elem), ...); }
+		void onClear() { (TTrackers::onClear(), ...); }
+		void onResize(size_t size) { (TTrackers::onResize(size), ...); }
+	};
+
+	// the default tracker, which tracks nothing.
+	class NoTracker
+	{
+	protected:
+		template<typename T>
+		void onPush(const T&) {}
+		template<typename T>
+		void onPop(const T&) {}
+		void onClear() {}
+		void onResize(size_t) {}
+	};
+
+	// keeps a running sum of the elements in the queue, which makes avg() O(1).
+	//
+	// TSum = the data type of the sum.
+	// should be large enough to contain the sum of all the elements.
+	template<typename TSum>
+	class SumTracker
+	{
+	public:
+		TSum sum() const { return m_sum; }
+
+	protected:
+		template<typename T>
+		void onPush(const T& elem) { m_sum += (TSum)elem; }
+		template<typename T>
+		void onPop(const T& elem) { m_sum -= (TSum)elem; }
+		void onClear() { m_sum = TSum(0); }
+		void onResize(size_t) {}
+
+		TSum m_sum = TSum(0);
+	};
+
+	namespace Bases
+	{
+		// a floating point sum using compensated (Kahan-Babuska) summation,
+		// which keeps the rounding errors of many additions and subtractions from building up.
+		template<typename TFloat>
+		class CompensatedSum
+		{
+		public:
+			TFloat value() const { return m_sum + m_compensation; }
+
+			void add(TFloat value)
+			{
+				TFloat new_sum = m_sum + value;
+
+				// recover the bits lost from whichever operand had the smallest magnitude
+				if (std::abs(m_sum) >= std::abs(value))
+					m_compensation += (m_sum - new_sum) + value;
+				else
+					m_compensation += (value - new_sum) + m_sum;
+
+				m_sum = new_sum;
+			}
+
+			void clear() { m_sum = TFloat(0); m_compensation = TFloat(0); }
+
+		protected:
+			TFloat m_sum = TFloat(0);
+			// stores the low order bits lost when adding to m_sum
+			TFloat m_compensation = TFloat(0);
+		};
+	}
+
+	// same as SumTracker, but uses compensated summation.
+	// should be used for floating point data types, where adding and removing elements would otherwise let rounding errors build up in the sum.
+	template<typename TSum>
+	class KahanSumTracker
+	{
+	public:
+		TSum sum() const { return m_sum.value(); }
+
+	protected:
+		template<typename T>
+		void onPush(const T& elem) { m_sum.add((TSum)elem); }
+		template<typename T>
+		void onPop(const T& elem) { m_sum.add(-(TSum)elem); }
+		void onClear() { m_sum.clear(); }
+		void onResize(size_t) {}
+
+		Bases::CompensatedSum<TSum> m_sum;
+	};
+
+	// keeps the mean and variance of the queue up to date in O(1), which makes variance() and stddev() O(1).
+	//
+	// uses Welford's algorithm, extended to also remove elements,
+	// where the mean and the sum of squared differences from the mean are updated with compensated summation to stay stable over many updates.
+	//
+	// TFloat = the floating point data type the moments are stored in.
+	template<typename TFloat = double>
+	class MomentTracker
+	{
+	public:
+		TFloat trackedMean() const { return m_mean.value(); }
+		// returns the population variance, or 0 if the queue is empty.
+		TFloat trackedVariance() const
+		{
+			if (m_count == 0)
+				return TFloat(0);
+
+			// rounding can push a variance of 0 slightly below 0
+			return std::max(TFloat(0), m_squared_diff.value() / (TFloat)m_count);
+		}
+
+	protected:
+		template<typename T>
+		void onPush(const T& elem)
+		{
+			TFloat x = (TFloat)elem;
+			m_count++;
+
+			TFloat delta = x - m_mean.value();
+			m_mean.add(delta / (TFloat)m_count);
+			m_squared_diff.add(delta * (x - m_mean.value()));
+		}
+
+		template<typename T>
+		void onPop(const T& elem)
+		{
+			// start from exact zeros when the queue runs empty, instead of carrying over rounding errors.
+			if (m_count <= 1)
+			{
+				onClear();
+				return;
+			}
+
+			TFloat x = (TFloat)elem;
+			m_count--;
+
+			TFloat delta = x - m_mean.value();
+			m_mean.add(-delta / (TFloat)m_count);
+			m_squared_diff.add(-delta * (x - m_mean.value()));
+		}
+
+		void onClear()
+		{
+			m_count = 0;
+			m_mean.clear();
+			m_squared_diff.clear();
+		}
+
+		void onResize(size_t) {}
+
+		size_t m_count = 0;
+		Bases::CompensatedSum<TFloat> m_mean;
+		// sum of squared differences from the mean
+		Bases::CompensatedSum<TFloat> m_squared_diff;
+	};
+
+	// keeps an exponentially weighted moving average of every element pushed to the queue, since it was last cleared.
+	// popped elements are not removed from the average, as their weight decays on its own.
+	//
+	// by default the smoothing factor is 2 / (size + 1), which gives the elements in the queue about 86% of the weight.
+	// setAlpha overrides this, until the queue is resized.
+	template<typename TFloat = double>
+	class EWMATracker
+	{
+	public:
+		// returns 0 if no elements has been pushed.
+		TFloat ewma() const { return m_ewma; }
+
+		TFloat alpha() const { return m_alpha; }
+		void setAlpha(TFloat alpha) { m_alpha = alpha; }
+
+	protected:
+		template<typename T>
+		void onPush(const T& elem)
+		{
+			if (m_empty)
+				m_ewma = (TFloat)elem;
+			else
+				m_ewma += m_alpha * ((TFloat)elem - m_ewma);
+
+			m_empty = false;
+		}
+
+		template<typename T>
+		void onPop(const T&) {}
+
+		void onClear()
+		{
+			m_ewma = TFloat(0);
+			m_empty = true;
+		}
+
+		void onResize(size_t size) { m_alpha = TFloat(2) / TFloat(size + 1); }
+
+		TFloat m_ewma = TFloat(0);
+		TFloat m_alpha = TFloat(1);
+		bool m_empty = true;
+	};
+
+	namespace Bases
+	{
+		/*
+		a deque of elements and the sequence number they were pushed with, sorted by TCompare from front to back.
+
+		when a value is pushed, every value at the back which compares less than it is removed first,
+		as the new value outlives them in the window and will always be preferred over them.
+		this leaves the preferred value of the window at the front.
+
+		used by MinMaxTracker, the storage is allocated on resize.
+		*/
+		template<typename T, typename TCompare>
+		class MonotonicDeque
+		{
+		public:
+			struct Entry
+			{
+				size_t sequence;
+				T value;
+			};
+
+			void resize(size_t size) { m_entries.resize(size); clear(); }
+			void clear() { m_front_index = 0; m_size = 0; }
+
+			void push(size_t sequence, const T& value)
+			{
+				while (m_size > 0 && TCompare()(m_entries[wrap(m_front_index + m_size - 1)].value, value))
+					m_size--;
+
+				m_entries[wrap(m_front_index + m_size)] = { sequence, value };
+				m_size++;
+			}
+
+			// pops the front if it was pushed with the passed sequence number.
+			void pop(size_t sequence)
+			{
+				if (m_size > 0 && front().sequence == sequence)
+				{
+					m_front_index = wrap(m_front_index + 1);
+					m_size--;
+				}
+			}
+
+			const Entry& front() const { return m_entries[m_front_index]; }
+
+		protected:
+			std::vector<Entry> m_entries;
+			size_t m_front_index = 0;
+			size_t m_size = 0;
+
+			// indices never exceed twice the size, so a subtraction is enough to wrap them.
+			size_t wrap(size_t index) const { return index >= m_entries.size() ? index - m_entries.size() : index; }
+		};
+	}
+
+	// keeps the maximum and minimum of the queue, and their indices, up to date in amortized O(1),
+	// which makes max(), min(), iOfMax() and iOfMin() O(1) when called without an offset.
+	// if the extremum occurs more than once, the first instance is tracked.
+	//
+	// stores up to two copies of each element in the queue.
+	template<typename T>
+	class MinMaxTracker
+	{
+	public:
+		// the queue must not be empty.
+		const T& trackedMax() const { return m_max.front().value; }
+		size_t trackedIOfMax() const { return m_max.front().sequence - m_popped; }
+
+		const T& trackedMin() const { return m_min.front().value; }
+		size_t trackedIOfMin() const { return m_min.front().sequence - m_popped; }
+
+	protected:
+		void onPush(const T& elem)
+		{
+			m_max.push(m_pushed, elem);
+			m_min.push(m_pushed, elem);
+			m_pushed++;
+		}
+
+		void onPop(const T&)
+		{
+			m_max.pop(m_popped);
+			m_min.pop(m_popped);
+			m_popped++;
+		}
+
+		void onClear()
+		{
+			m_max.clear();
+			m_min.clear();
+			m_pushed = 0;
+			m_popped = 0;
+		}
+
+		void onResize(size_t size)
+		{
+			m_max.resize(size);
+			m_min.resize(size);
+		}
+
+		// elements are numbered in the order they are pushed, so the index of an element is its number minus the number of popped elements.
+		size_t m_pushed = 0;
+		size_t m_popped = 0;
+
+		Bases::MonotonicDeque<T, std::less<T>> m_max;
+		Bases::MonotonicDeque<T, std::greater<T>> m_min;
+	};
+
+	namespace Bases
+	{
+		/*
+		a treap of values and their number of occurrences, used by QuantileTracker.
+
+		every node also stores the number of values in its subtree, so the value with a given rank can be found in O(log n).
+		the nodes are stored in a pool allocated on resize, and are referred to by their index in it.
+		values are only compared with operator<.
+		*/
+		template<typename T>
+		class OrderStatisticTree
+		{
+		public:
+			// allocates room for size distinct values, and clears the tree.
+			void resize(size_t size);
+			void clear();
+
+			void insert(const T& value) { m_root = insert(m_root, value); }
+			// removes one instance of value, which must be in the tree.
+			void erase(const T& value) { m_root = erase(m_root, value); }
+
+			// returns the value at rank in sorted order, 0 being the smallest.
+			const T& atRank(size_t rank) const;
+
+			size_t size() const { return subtreeSize(m_root); }
+
+		protected:
+			static constexpr size_t NIL = SIZE_MAX;
+
+			struct Node
+			{
+				T value;
+				size_t count;
+				size_t size;
+				uint32_t priority;
+				size_t left;
+				size_t right;
+			};
+
+			std::vector<Node> m_nodes;
+			// indices of the unused nodes in m_nodes
+			std::vector<size_t> m_free;
+			size_t m_root = NIL;
+			uint32_t m_seed = 0x9E3779B9;
+
+			size_t subtreeSize(size_t node) const { return node == NIL ? 0 : m_nodes[node].size; }
+			void update(size_t node) { m_nodes[node].size = m_nodes[node].count + subtreeSize(m_nodes[node].left) + subtreeSize(m_nodes[node].right); }
+
+			// rotates the left child up, and returns it.
+			size_t rotateRight(size_t node);
+			// rotates the right child up, and returns it.
+			size_t rotateLeft(size_t node);
+
+			size_t insert(size_t node, const T& value);
+			size_t erase(size_t node, const T& value);
+
+			uint32_t nextPriority();
+		};
+	}
+
+	// keeps the elements of the queue in an order statistic tree, which makes quantile() and rank queries O(log n).
+	//
+	// allocates a node for every distinct element on resize, equal elements share the same node.
+	template<typename T>
+	class QuantileTracker
+	{
+	public:
+		// returns the element at rank in sorted order, 0 being the smallest.
+		const T& trackedRank(size_t rank) const { return m_tree.atRank(rank); }
+
+		// returns the q quantile (0 <= q <= 1) of the queue using the nearest rank method, the queue must not be empty.
+		const T& trackedQuantile(double q) const { return m_tree.atRank(quantileRank(q, m_tree.size())); }
+
+		// returns the rank the nearest rank method picks for the q quantile of count elements.
+		static size_t quantileRank(double q, size_t count)
+		{
+			size_t rank = (size_t)std::ceil(q * (double)count);
+			return std::min(rank > 0 ? rank - 1 : 0, count - 1);
+		}
+
+	protected:
+		void onPush(const T& elem) { m_tree.insert(elem); }
+		void onPop(const T& elem) { m_tree.erase(elem); }
+		void onClear() { m_tree.clear(); }
+		void onResize(size_t size) { m_tree.resize(size); }
+
+		Bases::OrderStatisticTree<T> m_tree;
+	};
+
+	namespace Bases
+	{
+		template<typename T>
+		void OrderStatisticTree<T>::resize(size_t size)
+		{
+			m_nodes.resize(size);
+			clear();
+		}
+
+		template<typename T>
+		void OrderStatisticTree<T>::clear()
+		{
+			m_root = NIL;
+			m_free.resize(m_nodes.size());
+
+			// hand out the nodes from the start of the pool
+			for (size_t i = 0; i < m_free.size(); i++)
+				m_free[i] = m_free.size() - 1 - i;
+		}
+
+		template<typename T>
+		const T& OrderStatisticTree<T>::atRank(size_t rank) const
+		{
+			assert(rank < size());
+
+			size_t node = m_root;
+
+			while (true)
+			{
+				size_t left_size = subtreeSize(m_nodes[node].left);
+
+				if (rank < left_size)
+				{
+					node = m_nodes[node].left;
+				}
+				else if (rank < left_size + m_nodes[node].count)
+				{
+					return m_nodes[node].value;
+				}
+				else
+				{
+					rank -= left_size + m_nodes[node].count;
+					node = m_nodes[node].right;
+				}
+			}
+		}
+
+		template<typename T>
+		size_t OrderStatisticTree<T>::rotateRight(size_t node)
+		{
+			size_t left = m_nodes[node].left;
+
+			m_nodes[node].left = m_nodes[left].right;
+			m_nodes[left].right = node;
+
+			update(node);
+			update(left);
+
+			return left;
+		}
+
+		template<typename T>
+		size_t OrderStatisticTree<T>::rotateLeft(size_t node)
+		{
+			size_t right = m_nodes[node].right;
+
+			m_nodes[node].right = m_nodes[right].left;
+			m_nodes[right].left = node;
+
+			update(node);
+			update(right);
+
+			return right;
+		}
+
+		template<typename T>
+		size_t OrderStatisticTree<T>::insert(size_t node, const T& value)
+		{
+			if (node == NIL)
+			{
+				assert(!m_free.empty());
+
+				size_t new_node = m_free.back();
+				m_free.pop_back();
+
+				m_nodes[new_node] = { value, 1, 1, nextPriority(), NIL, NIL };
+
+				return new_node;
+			}
+
+			if (value < m_nodes[node].value)
+			{
+				m_nodes[node].left = insert(m_nodes[node].left, value);
+
+				// restore the heap order of the priorities
+				if (m_nodes[m_nodes[node].left].priority > m_nodes[node].priority)
+					return rotateRight(node);
+			}
+			else if (m_nodes[node].value < value)
+			{
+				m_nodes[node].right = insert(m_nodes[node].right, value);
+
+				if (m_nodes[m_nodes[node].right].priority > m_nodes[node].priority)
+					return rotateLeft(node);
+			}
+			else
+			{
+				m_nodes[node].count++;
+			}
+
+			update(node);
+
+			return node;
+		}
+
+		template<typename T>
+		size_t OrderStatisticTree<T>::erase(size_t node, const T& value)
+		{
+			assert(node != NIL);
+
+			if (value < m_nodes[node].value)
+			{
+				m_nodes[node].left = erase(m_nodes[node].left, value);
+			}
+			else if (m_nodes[node].value < value)
+			{
+				m_nodes[node].right = erase(m_nodes[node].right, value);
+			}
+			else if (m_nodes[node].count > 1)
+			{
+				m_nodes[node].count--;
+			}
+			else
+			{
+				size_t left = m_nodes[node].left;
+				size_t right = m_nodes[node].right;
+
+				if (left == NIL || right == NIL)
+				{
+					m_free.push_back(node);
+					return left == NIL ? right : left;
+				}
+
+				// rotate the node down below the child with the highest priority, and remove it from there.
+				if (m_nodes[left].priority > m_nodes[right].priority)
+				{
+					size_t new_root = rotateRight(node);
+					m_nodes[new_root].right = erase(node, value);
+					update(new_root);
+					return new_root;
+				}
+				else
+				{
+					size_t new_root = rotateLeft(node);
+					m_nodes[new_root].left = erase(node, value);
+					update(new_root);
+					return new_root;
+				}
+			}
+
+			update(node);
+
+			return node;
+		}
+
+		template<typename T>
+		uint32_t OrderStatisticTree<T>::nextPriority()
+		{
+			// xorshift32
+			m_seed ^= m_seed << 13;
+			m_seed ^= m_seed >> 17;
+			m_seed ^= m_seed << 5;
+
+			return m_seed;
+		}
+	}
+}
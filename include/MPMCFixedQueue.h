@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <algorithm>
+#include "FixedQueue.h"
+
+namespace ADS
+{
+	/*
+	a fixed size queue that can be pushed to and popped from by any number of threads, without any locks.
+
+	based on Dmitry Vyukov's bounded queue, every slot stores a sequence number next to the element,
+	which tells a pushing / popping thread if the slot is ready for it.
+
+	slot i starts with the sequence number i.
+	a push claims position pos if the sequence of its slot equals pos, writes the element and sets the sequence to pos + 1.
+	a pop claims position pos if the sequence of its slot equals pos + 1, reads the element and sets the sequence to pos + size,
+	which is the position of the next push into that slot.
+
+	like FixedQueue, all memory is allocated on construction.
+	the size is at least 2: with a single slot, the sequence a pop leaves for the next push (pos + 1) equals the one a push leaves for the pop,
+	so a push could overwrite an element that was not popped and a pop would wait for a push that never comes.
+	*/
+	template<typename T, typename TCapacity = ModCapacity>
+	class MPMCFixedQueue
+	{
+	public:
+		// sizes below 2 are raised to 2, see above.
+		MPMCFixedQueue(size_t size);
+		~MPMCFixedQueue() { delete[] m_slots; }
+
+		MPMCFixedQueue(const MPMCFixedQueue&) = delete;
+		MPMCFixedQueue& operator=(const MPMCFixedQueue&) = delete;
+
+		// pushes elem to the back of the queue, returns false if the queue is full.
+		bool try_push(const T& elem);
+		// pushes elem to the back of the queue, if the queue is full the front is popped to make room for it.
+		// this mirrors the behaviour of FixedQueue::push_back. the popped element is left in its slot, no temporary T is constructed.
+		void push_back(const T& elem);
+
+		// moves the front of the queue into target and pops it, returns false if the queue is empty.
+		bool try_pop(T& target);
+
+		size_t size() const { return m_fixed_size; }
+		// the length is only a snapshot, as other threads may push or pop at any time.
+		size_t length() const;
+
+		bool full() const { return length() == size(); }
+		bool empty() const { return length() == 0; }
+
+	protected:
+		// pops the front into target, or only frees its slot if target is nullptr.
+		bool popFront(T* target);
+
+		struct Slot
+		{
+			std::atomic<size_t> sequence;
+			T data;
+		};
+
+		const size_t m_fixed_size;
+		Slot* const m_slots;
+
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_push_pos = 0;
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_pop_pos = 0;
+	};
+}
+
+#include "MPMCFixedQueue.ipp"
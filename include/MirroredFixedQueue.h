@@ -0,0 +1,57 @@
+#pragma once
+
+#include "FixedQueue.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ADS_MIRRORED_FIXED_QUEUE
+
+namespace ADS
+{
+	/*
+	a FixedQueue where the buffer is mapped twice back to back in virtual memory,
+	so writing past the end of the buffer writes to the start of it.
+
+	(SIZE = 4)
+	 FRONT          BACK
+	 |              |
+	[3, 4, 1, 2][3, 4, 1, 2]
+	       ^  ^  ^  ^
+	       same physical pages
+
+	this means all the elements of the queue can be read contiguously from the front, without any wrapping,
+	so operator[] skips the modulo, spans() always returns a single span, and data() can be passed directly to write() and similar functions.
+
+	the size is rounded up, so the buffer is a whole number of pages.
+	only available on posix systems, and only for trivially copyable types, as every element is accessible from two addresses.
+	*/
+	template<typename T, typename TTracker = NoTracker> requires std::is_trivially_copyable_v<T>
+	class MirroredFixedQueue: public Bases::FixedQueueBase<T, MirroredCapacity, TTracker>
+	{
+	public:
+		// throws std::bad_alloc if the memory could not be mapped.
+		MirroredFixedQueue(size_t size);
+		~MirroredFixedQueue();
+
+		MirroredFixedQueue(const MirroredFixedQueue&) = delete;
+		MirroredFixedQueue& operator=(const MirroredFixedQueue&) = delete;
+
+		// returns a pointer to the front of the queue, from which all length() elements can be read contiguously.
+		T* data() { return m_data + m_front_index; }
+		const T* data() const { return m_data + m_front_index; }
+
+		// returns the smallest size larger than or equal to size, which fills a whole number of pages.
+		static size_t mirroredSize(size_t size);
+
+	protected:
+		using Bases::FixedQueueBase<T, MirroredCapacity, TTracker>::m_data;
+		using Bases::FixedQueueBase<T, MirroredCapacity, TTracker>::m_fixed_size;
+		using Bases::FixedQueueBase<T, MirroredCapacity, TTracker>::m_front_index;
+
+		// maps size elements twice back to back, and returns the address of the first mapping.
+		static T* mapMirrored(size_t size);
+	};
+}
+
+#include "MirroredFixedQueue.ipp"
+
+#endif
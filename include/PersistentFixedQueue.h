@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "FixedQueue.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ADS_PERSISTENT_FIXED_QUEUE
+
+namespace ADS
+{
+	/*
+	a FixedQueue stored in a memory mapped file, so the elements are kept when the process exits and the queue can be reopened right away.
+	pages of the file are only read from disk when they are accessed.
+
+	FILE LAYOUT:
+	HEADER = MAGIC + VERSION + ELEMENT SIZE + ELEMENT ALIGNMENT + CAPACITY + STATE[2]
+	STATE = GENERATION + FRONT INDEX + SIZE + CHECKSUM
+	FILE = HEADER padded to a whole page + ELEMENTS...
+
+	CRASH CONSISTENCY:
+	the elements are written directly into the file, but the front index and size are only written to the header by commit.
+	commit writes them to the state not used by the last commit, with the next generation and a checksum over the state,
+	and the state with the highest generation and a valid checksum is loaded when the file is opened.
+	so if the process crashes during a commit, the queue is restored as it was at the previous commit.
+
+	without a flush, a commit survives a crash of the process, as the pages belong to the os, but not a crash of the os or a power loss.
+	commit(true) flushes the elements before writing the state, and then flushes the header,
+	so the state on disk never refers to elements which have not been written to disk.
+
+	elements pushed after the last commit may have overwritten elements of the committed state, those are restored with their new values.
+	the destructor commits without flushing.
+
+	the file is only portable between processes using the same T, so it must not be shared between machines with different endianness.
+	only available on posix systems, and only for trivially copyable types.
+	*/
+	template<typename T, typename TTracker = NoTracker> requires std::is_trivially_copyable_v<T>
+	class PersistentFixedQueue: public Bases::FixedQueueBase<T, ModCapacity, TTracker>
+	{
+	public:
+		// bumped whenever the file layout changes, files of other versions are rejected.
+		static constexpr uint32_t VERSION = 1;
+
+		// opens the queue stored at path, or creates it with space for size elements if the file does not exist, is empty,
+		// or was left without a header by a crash while it was created.
+		// throws std::system_error if the file can not be opened or mapped,
+		// and std::runtime_error if the file is not a queue of size elements of the same size and alignment as T, or both states are corrupt.
+		PersistentFixedQueue(const std::string& path, size_t size);
+		~PersistentFixedQueue();
+
+		PersistentFixedQueue(const PersistentFixedQueue&) = delete;
+		PersistentFixedQueue& operator=(const PersistentFixedQueue&) = delete;
+
+		// writes the front index and size to the header, so the current elements are restored when the file is reopened.
+		// if flush is true, the elements and the header are also flushed to disk, see CRASH CONSISTENCY.
+		// throws std::system_error if a flush fails.
+		void commit(bool flush = false);
+
+	protected:
+		struct State
+		{
+			uint64_t generation;
+			uint64_t front_index;
+			uint64_t size;
+			uint64_t checksum;
+		};
+
+		struct Header
+		{
+			uint64_t magic;
+			uint32_t version;
+			uint32_t element_size;
+			uint64_t element_alignment;
+			uint64_t capacity;
+			State states[2];
+		};
+
+		static constexpr uint64_t MAGIC = 0x5545555146534441; // "ADSFQUEU"
+
+		static uint64_t checksum(const State& state);
+		// returns the offset of the elements from the start of the file.
+		static size_t dataOffset();
+
+		// maps the file at path, and loads the last committed state or initializes the header of a new file.
+		void open(const std::string& path);
+
+		using Bases::FixedQueueBase<T, ModCapacity, TTracker>::m_data;
+		using Bases::FixedQueueBase<T, ModCapacity, TTracker>::m_fixed_size;
+		using Bases::FixedQueueBase<T, ModCapacity, TTracker>::m_size;
+		using Bases::FixedQueueBase<T, ModCapacity, TTracker>::m_front_index;
+
+		Header* m_header = nullptr;
+		size_t m_mapped_bytes = 0;
+		uint64_t m_generation = 0;
+	};
+}
+
+#include "PersistentFixedQueue.ipp"
+
+#endif
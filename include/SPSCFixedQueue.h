@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <algorithm>
+#include "FixedQueue.h"
+
+namespace ADS
+{
+	/*
+	a fixed size queue that can be pushed to from one thread and popped from another thread, without any locks.
+
+	uses the same cyclic buffer layout as FixedQueue, but elements are never overwritten,
+	instead try_push fails if the queue is full.
+
+	m_head and m_tail count the total number of pops and pushes, and are wrapped by TCapacity when indexing m_data.
+	the producer only writes m_tail and the consumer only writes m_head, each on their own cache line.
+	both sides keep a cached copy of the other sides index, so the shared cache line is only read when the cached value says the queue is full / empty.
+
+	only one thread may call the push functions, and only one thread may call the pop functions.
+	*/
+	template<typename T, typename TCapacity = ModCapacity>
+	class SPSCFixedQueue
+	{
+	public:
+		SPSCFixedQueue(size_t size);
+		~SPSCFixedQueue() { delete[] m_data; }
+
+		SPSCFixedQueue(const SPSCFixedQueue&) = delete;
+		SPSCFixedQueue& operator=(const SPSCFixedQueue&) = delete;
+
+		// pushes elem to the back of the queue, returns false if the queue is full.
+		bool try_push(const T& elem);
+		// pushes elements from the range until either the range or the queue runs out of space.
+		// returns the number of elements pushed.
+		template<Bases::i_iterator_ct<T> TIter>
+		size_t try_push(TIter begin, TIter end);
+
+		// moves the front of the queue into target and pops it, returns false if the queue is empty.
+		bool try_pop(T& target);
+		// pops up to elem_count elements into target.
+		// returns the number of elements popped.
+		size_t try_pop(T* target, size_t elem_count);
+
+		size_t size() const { return m_fixed_size; }
+		// the length is only a snapshot, as the other thread may push or pop at any time.
+		size_t length() const { return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire); }
+
+		bool full() const { return length() == size(); }
+		bool empty() const { return length() == 0; }
+
+	protected:
+		const size_t m_fixed_size;
+		T* const m_data;
+
+		// consumer side
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_head = 0;
+		size_t m_tail_cache = 0;
+
+		// producer side
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_tail = 0;
+		size_t m_head_cache = 0;
+
+		// returns the number of free slots seen by the producer, only reloads m_head if the cached value is not enough.
+		size_t freeSlots(size_t tail, size_t required);
+		// returns the number of filled slots seen by the consumer, only reloads m_tail if the cached value is not enough.
+		size_t filledSlots(size_t head, size_t required);
+	};
+}
+
+#include "SPSCFixedQueue.ipp"
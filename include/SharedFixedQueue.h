@@ -0,0 +1,142 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include "FixedQueue.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ADS_SHARED_FIXED_QUEUE
+
+namespace ADS
+{
+	/*
+	a fixed size queue in posix shared memory, for passing elements between processes without sockets or pipes.
+	one process creates the queue under a name, and other processes attach to it by the same name.
+
+	the slots use the same sequence numbers as MPMCFixedQueue, and everything in the shared memory is stored as positions and offsets,
+	so the processes can map it at different addresses.
+	there may only be one consumer, and one producer unless multi_producer is true.
+	like MPMCFixedQueue, the size is at least 2.
+
+	SHARED MEMORY LAYOUT:
+	HEADER = MAGIC + VERSION + ELEMENT SIZE + ELEMENT ALIGNMENT + CAPACITY + FLAGS + READY + PUSH POSITION + POP POSITION + WAKEUP
+	SHARED MEMORY = HEADER + SLOTS...
+
+	ATTACHING AND DETACHING:
+	the creator sets READY once the header and slots are initialized, attaching waits for it and fails if it is not set in time,
+	or if the queue was created for another element type or version.
+	the destructor unmaps the shared memory. the creator also removes the name, but processes which are attached keep the queue until they detach.
+	a queue left behind by a crashed creator can be removed with remove.
+
+	WAKEUP:
+	if the queue is created with wakeup enabled, a consumer blocked in pop_wait sleeps on a futex on linux, and every push wakes it if it is sleeping.
+	this costs a fence on every push, so it is only enabled on request. without it, or on other systems, pop_wait sleeps for short intervals instead.
+
+	only available on posix systems, and only for trivially copyable types.
+	*/
+	template<typename T, bool multi_producer = false, typename TCapacity = ModCapacity> requires std::is_trivially_copyable_v<T>
+	class SharedFixedQueue
+	{
+	public:
+		// bumped whenever the shared memory layout changes, queues of other versions can not be attached to.
+		static constexpr uint32_t VERSION = 1;
+
+		// creates the queue under name, which must start with a '/' like for shm_open. sizes below 2 are raised to 2.
+		// throws std::system_error if the shared memory can not be created or mapped, including if the name is already in use.
+		SharedFixedQueue(const std::string& name, size_t size, bool wakeup = false);
+		// attaches to the queue created under name, waiting up to timeout for the creator to initialize it.
+		// throws std::system_error if the shared memory can not be opened or mapped,
+		// and std::runtime_error if it is not initialized in time or holds a queue of another T, version or multi_producer,
+		// or with a capacity TCapacity would not have chosen, like a queue created with ModCapacity and attached with Pow2Capacity.
+		SharedFixedQueue(const std::string& name, std::chrono::milliseconds timeout = std::chrono::seconds(1));
+		~SharedFixedQueue();
+
+		SharedFixedQueue(const SharedFixedQueue&) = delete;
+		SharedFixedQueue& operator=(const SharedFixedQueue&) = delete;
+
+		// removes the name of a queue, returns false if there is no queue under name.
+		static bool remove(const std::string& name);
+
+		// pushes elem to the back of the queue, returns false if the queue is full.
+		bool try_push(const T& elem);
+
+		// copies the front of the queue into target and pops it, returns false if the queue is empty.
+		bool try_pop(T& target);
+		// pops up to elem_count elements into target.
+		// returns the number of elements popped.
+		size_t try_pop(T* target, size_t elem_count);
+
+		// pops the front of the queue into target, waiting for an element to be pushed if the queue is empty.
+		void pop_wait(T& target);
+		// same as pop_wait, but returns false if no element was pushed within timeout.
+		bool pop_wait_for(T& target, std::chrono::nanoseconds timeout);
+
+		size_t size() const { return m_fixed_size; }
+		// the length is only a snapshot, as the other processes may push or pop at any time.
+		size_t length() const;
+
+		bool full() const { return length() == size(); }
+		bool empty() const { return length() == 0; }
+
+	protected:
+		struct Slot
+		{
+			std::atomic<uint64_t> sequence;
+			T data;
+		};
+
+		struct Header
+		{
+			uint64_t magic;
+			uint32_t version;
+			uint32_t element_size;
+			uint64_t element_alignment;
+			uint64_t capacity;
+			uint32_t flags;
+
+			std::atomic<uint32_t> ready;
+
+			alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> push_pos;
+			alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> pop_pos;
+
+			// incremented by a push if waiters is not 0, a waiting consumer sleeps on it.
+			alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> signal;
+			std::atomic<uint32_t> waiters;
+		};
+
+		// the atomics have to work between processes, which is only guaranteed if they are lock free.
+		static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free);
+
+		static constexpr uint64_t MAGIC = 0x5545555148534441; // "ADSHQUEU"
+
+		static constexpr uint32_t MULTI_PRODUCER_FLAG = 1;
+		static constexpr uint32_t WAKEUP_FLAG = 2;
+
+		// returns the offset of the first slot from the start of the shared memory.
+		static constexpr size_t slotsOffset() { return (sizeof(Header) + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot); }
+
+		// maps bytes of the shared memory in fd, and sets m_header and m_slots.
+		void map(int fd, size_t bytes);
+
+		// wakes the consumer if it is waiting in pop_wait.
+		void notify();
+		// waits until an element is popped into target or until deadline.
+		bool waitUntil(T& target, std::chrono::steady_clock::time_point deadline);
+
+		std::string m_name;
+		bool m_owner;
+		bool m_wakeup = false;
+
+		size_t m_fixed_size = 0;
+		size_t m_mapped_bytes = 0;
+
+		Header* m_header = nullptr;
+		Slot* m_slots = nullptr;
+	};
+}
+
+#include "SharedFixedQueue.ipp"
+
+#endif
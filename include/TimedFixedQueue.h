@@ -0,0 +1,118 @@
+#pragma once
+
+#include <chrono>
+#include "FixedQueue.h"
+
+namespace ADS
+{
+	/*
+	a FixedQueue holding the elements pushed within the last window of time, instead of the last n elements.
+
+	every element is pushed with a timestamp from TClock, and elements older than the window are evicted from the front.
+	eviction is lazy, it happens on every push and on every query, so a queue which is not touched keeps its expired elements until it is.
+	the timestamps are kept in a second FixedQueue of the same size next to the elements, so no memory is allocated after construction.
+
+	(WINDOW = 10s)
+	 FRONT         BACK
+	 |             |
+	[a@1s, b@4s, c@12s] push d at 15s
+	          |
+	          v
+	 FRONT   BACK
+	 |       |
+	[c@12s, d@15s]
+
+	the size still caps the number of elements, if the queue is full the oldest element is overwritten like in a FixedQueue,
+	so the size should cover the most elements which can be pushed within one window.
+
+	TTracker keeps its aggregates over the live elements only, as evicted elements are popped like any other element,
+	so avg, max and min stay O(1) with the matching tracker, see FixedQueueTrackers.h.
+
+	TClock = the clock the timestamps are taken from, it must be monotonic for eviction to work.
+	*/
+	template<typename T, typename TCapacity = ModCapacity, typename TTracker = NoTracker, typename TClock = std::chrono::steady_clock>
+	class TimedFixedQueue
+	{
+	public:
+		using time_point = typename TClock::time_point;
+		using duration = typename TClock::duration;
+
+		TimedFixedQueue(duration window, size_t size);
+
+		// pushes the element with the current time as its timestamp, after evicting the expired elements.
+		void push_back(const T& elem) { emplaceAt(TClock::now(), elem); }
+		void push_back(T&& elem) { emplaceAt(TClock::now(), std::move(elem)); }
+		template<typename... TArgs> requires std::is_constructible_v<T, TArgs...>
+		T& emplace_back(TArgs&&... args) { return emplaceAt(TClock::now(), std::forward<TArgs>(args)...); }
+
+		// pushes the element with the passed timestamp, which must not be older than the timestamp of the back.
+		void push_back(const T& elem, time_point timestamp) { emplaceAt(timestamp, elem); }
+		void push_back(T&& elem, time_point timestamp) { emplaceAt(timestamp, std::move(elem)); }
+		template<typename... TArgs> requires std::is_constructible_v<T, TArgs...>
+		T& emplaceAt(time_point timestamp, TArgs&&... args);
+
+		inline void push(const T& elem) { push_back(elem); }
+		inline void push(T&& elem) { push_back(std::move(elem)); }
+
+		// pops the elements older than the window as of now, and returns the number of elements popped.
+		size_t evict() { return evict(TClock::now()); }
+		size_t evict(time_point now);
+
+		// the accessors below evict the expired elements first, the queue must not be empty after that.
+		T& front() { evict(); return m_queue.front(); }
+		T& back() { evict(); return m_queue.back(); }
+		time_point frontTime() { evict(); return m_timestamps.front(); }
+		time_point backTime() { evict(); return m_timestamps.back(); }
+
+		void pop_front(size_t elem_count = 1);
+		inline void pop(size_t elem_count = 1) { pop_front(elem_count); }
+
+		size_t size() const { return m_queue.size(); }
+		// returns the number of elements within the window.
+		size_t length() { evict(); return m_queue.length(); }
+		size_t count() { return length(); }
+
+		bool full() { return length() == size(); }
+		bool empty() { return length() == 0; }
+
+		duration window() const { return m_window; }
+		// expired elements are evicted on the next push or query.
+		void setWindow(duration window) { m_window = window; }
+
+		// aggregates over the elements within the window, see FixedQueueBase.
+		template<typename TAvg = T> requires requires(T x) { x + x / x; }
+		T avg() { evict(); return m_queue.template avg<TAvg>(); }
+		T max() { evict(); return m_queue.max(); }
+		T min() { evict(); return m_queue.min(); }
+		size_t iOfMax() { evict(); return m_queue.iOfMax(); }
+		size_t iOfMin() { evict(); return m_queue.iOfMin(); }
+
+		template<typename TFloat = double>
+		TFloat variance() { evict(); return m_queue.template variance<TFloat>(); }
+		template<typename TFloat = double>
+		TFloat stddev() { evict(); return m_queue.template stddev<TFloat>(); }
+
+		T quantile(double q) { evict(); return m_queue.quantile(q); }
+		T median() { evict(); return m_queue.median(); }
+
+		// the sum kept by TTracker, if it keeps one.
+		auto sum() requires requires(const TTracker& tracker) { tracker.sum(); } { evict(); return m_queue.sum(); }
+
+		// returns the elements within the window, for reading them through the const members of FixedQueue, like iterating, spans or toVector.
+		// the aggregates are forwarded above, as most of them are not const members of FixedQueue.
+		// the queue must not be pushed to or popped from directly, as the timestamps would no longer match the elements.
+		const FixedQueue<T, TCapacity, TTracker>& elements() { evict(); return m_queue; }
+		const FixedQueue<time_point, TCapacity>& timestamps() { evict(); return m_timestamps; }
+
+		void clear();
+
+	protected:
+		duration m_window;
+
+		FixedQueue<T, TCapacity, TTracker> m_queue;
+		// the timestamp of every element at the same index as in m_queue.
+		FixedQueue<time_point, TCapacity> m_timestamps;
+	};
+}
+
+#include "TimedFixedQueue.ipp"
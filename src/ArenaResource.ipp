@@ -0,0 +1,46 @@
+#include "ArenaResource.h"
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace ADS
+{
+	template<typename TArena>
+	void* ArenaResource<TArena>::do_allocate(size_t bytes, size_t alignment)
+	{
+		// room for the block address, and for moving the returned address up to the alignment.
+		// the size is rounded up to keep the size headers of a StaticArena aligned.
+		size_t block_size = bytes + sizeof(byte*) + alignment - 1;
+		block_size = (block_size + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+		byte* block = m_arena.template alloc<byte>(block_size);
+
+		if (!block)
+			throw std::bad_alloc();
+
+		uintptr_t address = (reinterpret_cast<uintptr_t>(block + sizeof(byte*)) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+		byte* aligned = reinterpret_cast<byte*>(address);
+
+		std::memcpy(aligned - sizeof(byte*), &block, sizeof(byte*));
+
+		return aligned;
+	}
+
+	template<typename TArena>
+	void ArenaResource<TArena>::do_deallocate(void* address, size_t, size_t)
+	{
+		byte* block;
+		std::memcpy(&block, static_cast<byte*>(address) - sizeof(byte*), sizeof(byte*));
+
+		m_arena.free(block);
+	}
+
+	template<typename TArena>
+	bool ArenaResource<TArena>::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+	{
+		const ArenaResource* other_arena = dynamic_cast<const ArenaResource*>(&other);
+
+		return other_arena && &other_arena->m_arena == &m_arena;
+	}
+}
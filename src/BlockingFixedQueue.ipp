@@ -0,0 +1,177 @@
+#include "BlockingFixedQueue.h"
+
+#include <climits>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace ADS
+{
+	template<typename T, typename TCapacity>
+	template<Bases::i_iterator_ct<T> TIter>
+	void BlockingFixedQueue<T, TCapacity>::push_wait(TIter begin, TIter end)
+	{
+		while (begin != end)
+		{
+			// loaded before checking the queue, so a pop after the check changes it and the wait below returns right away.
+			uint32_t pop_count = m_pop_count.load(std::memory_order_seq_cst);
+			size_t pushed = 0;
+
+			{
+				std::lock_guard lock(m_mutex);
+
+				for (; begin != end && !m_queue.full(); ++begin, pushed++)
+					m_queue.emplace_back(*begin);
+			}
+
+			if (pushed)
+				notifyPushed(pushed);
+
+			if (begin != end)
+			{
+				m_push_waiters.fetch_add(1, std::memory_order_seq_cst);
+				waitChange(m_pop_count, pop_count, std::chrono::steady_clock::time_point::max());
+				m_push_waiters.fetch_sub(1, std::memory_order_relaxed);
+			}
+		}
+	}
+
+	template<typename T, typename TCapacity>
+	size_t BlockingFixedQueue<T, TCapacity>::length() const
+	{
+		std::lock_guard lock(m_mutex);
+		return m_queue.length();
+	}
+
+	template<typename T, typename TCapacity>
+	template<typename TElem>
+	bool BlockingFixedQueue<T, TCapacity>::pushUntil(TElem&& elem, std::chrono::steady_clock::time_point deadline)
+	{
+		while (true)
+		{
+			uint32_t pop_count = m_pop_count.load(std::memory_order_seq_cst);
+
+			{
+				std::lock_guard lock(m_mutex);
+
+				if (!m_queue.full())
+				{
+					m_queue.push_back(std::forward<TElem>(elem));
+					break;
+				}
+			}
+
+			if (deadline != std::chrono::steady_clock::time_point::max() && std::chrono::steady_clock::now() >= deadline)
+				return false;
+
+			m_push_waiters.fetch_add(1, std::memory_order_seq_cst);
+			waitChange(m_pop_count, pop_count, deadline);
+			m_push_waiters.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		notifyPushed(1);
+
+		return true;
+	}
+
+	template<typename T, typename TCapacity>
+	size_t BlockingFixedQueue<T, TCapacity>::popUntil(T* target, size_t elem_count, std::chrono::steady_clock::time_point deadline)
+	{
+		// nothing to wait for, and popping 0 elements would never end the loop below
+		if (elem_count == 0)
+			return 0;
+
+		size_t popped = 0;
+
+		while (true)
+		{
+			uint32_t push_count = m_push_count.load(std::memory_order_seq_cst);
+
+			{
+				std::lock_guard lock(m_mutex);
+
+				popped = std::min(elem_count, m_queue.length());
+				m_queue.pop_front(target, popped);
+			}
+
+			if (popped)
+				break;
+
+			if (deadline != std::chrono::steady_clock::time_point::max() && std::chrono::steady_clock::now() >= deadline)
+				return 0;
+
+			m_pop_waiters.fetch_add(1, std::memory_order_seq_cst);
+			waitChange(m_push_count, push_count, deadline);
+			m_pop_waiters.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		notifyPopped(popped);
+
+		return popped;
+	}
+
+	template<typename T, typename TCapacity>
+	void BlockingFixedQueue<T, TCapacity>::notifyPushed(size_t elem_count)
+	{
+		// both are seq_cst, so either this sees the consumer registered as a waiter, or the consumer sees the new count and does not sleep.
+		m_push_count.fetch_add(1, std::memory_order_seq_cst);
+
+		if (m_pop_waiters.load(std::memory_order_seq_cst) > 0)
+			wake(m_push_count, elem_count);
+	}
+
+	template<typename T, typename TCapacity>
+	void BlockingFixedQueue<T, TCapacity>::notifyPopped(size_t elem_count)
+	{
+		m_pop_count.fetch_add(1, std::memory_order_seq_cst);
+
+		if (m_push_waiters.load(std::memory_order_seq_cst) > 0)
+			wake(m_pop_count, elem_count);
+	}
+
+	template<typename T, typename TCapacity>
+	void BlockingFixedQueue<T, TCapacity>::waitChange(std::atomic<uint32_t>& counter, uint32_t seen, std::chrono::steady_clock::time_point deadline)
+	{
+#if defined(__linux__)
+		timespec timeout;
+		timespec* timeout_ptr = nullptr;
+
+		if (deadline != std::chrono::steady_clock::time_point::max())
+		{
+			auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - std::chrono::steady_clock::now());
+
+			if (remaining.count() <= 0)
+				return;
+
+			timeout.tv_sec = remaining.count() / 1000000000;
+			timeout.tv_nsec = remaining.count() % 1000000000;
+			timeout_ptr = &timeout;
+		}
+
+		// returns right away if counter no longer equals seen.
+		syscall(SYS_futex, (uint32_t*)&counter, FUTEX_WAIT_PRIVATE, seen, timeout_ptr, nullptr, 0);
+#else
+		if (deadline == std::chrono::steady_clock::time_point::max())
+			counter.wait(seen, std::memory_order_seq_cst);
+		else if (counter.load(std::memory_order_seq_cst) == seen)
+			std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(deadline - std::chrono::steady_clock::now(), std::chrono::microseconds(50)));
+#endif
+	}
+
+	template<typename T, typename TCapacity>
+	void BlockingFixedQueue<T, TCapacity>::wake(std::atomic<uint32_t>& counter, size_t thread_count)
+	{
+#if defined(__linux__)
+		syscall(SYS_futex, (uint32_t*)&counter, FUTEX_WAKE_PRIVATE, (int)std::min<size_t>(thread_count, INT_MAX), nullptr, nullptr, 0);
+#else
+		if (thread_count == 1)
+			counter.notify_one();
+		else
+			counter.notify_all();
+#endif
+	}
+}
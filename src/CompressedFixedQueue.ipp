@@ -0,0 +1,317 @@
+#include "CompressedFixedQueue.h"
+
+namespace ADS
+{
+	template<Bases::compressible_ct T, size_t block_size>
+	CompressedFixedQueue<T, block_size>::CompressedFixedQueue(size_t size)
+		: m_blocks((size + block_size - 1) / block_size + 1)
+	{
+	}
+
+	template<Bases::compressible_ct T, size_t block_size>
+	void CompressedFixedQueue<T, block_size>::push_back(T elem)
+	{
+		if (m_length && m_blocks.back().length < block_size)
+		{
+			Block& block = m_blocks.back();
+
+			encode(block, elem, m_state);
+			block.length++;
+			block.min = std::min(block.min, elem);
+			block.max = std::max(block.max, elem);
+			block.sum = addSum(block.sum, elem);
+			m_length++;
+
+			// the block is complete, so the spare capacity of its bits is released.
+			if (block.length == block_size)
+				block.words.shrink_to_fit();
+
+			return;
+		}
+
+		if (m_blocks.full())
+			popBlock();
+
+		Block& block = m_blocks.emplace_back();
+		block.length = 1;
+		block.first = block.min = block.max = elem;
+		block.sum = elem;
+		m_length++;
+
+		m_state = CodecState();
+		m_state.value = elem;
+	}
+
+	template<Bases::compressible_ct T, size_t block_size>
+	void CompressedFixedQueue<T, block_size>::popBlock()
+	{
+		assert(!empty());
+
+		m_length -= m_blocks.front().length;
+		m_blocks.pop_front();
+	}
+
+	template<Bases::compressible_ct T, size_t block_size>
+	T CompressedFixedQueue<T, block_size>::avg() const
+	{
+		assert(!empty());
+
+		sum_type sum = 0;
+
+		for (const Block& block : m_blocks)
+			sum = addSum(sum, block.sum);
+
+		return (T)(sum / (sum_type)m_length);
+	}
+
+	template<Bases::compressible_ct T, size_t block_size>
+	T CompressedFixedQueue<T, block_size>::max() const
+	{
+		assert(!empty());
+
+		T result = m_blocks.begin()->max;
+
+		for (const Block& block : m_blocks)
+			result = std::max(result, block.max);
+
+		return result;
+	}
+
+	template<Bases::compressible_ct T, size_t block_size>
+	T CompressedFixedQueue<T, block_size>::min() const
+	{
+		assert(!empty());
+
+		T result = m_blocks.begin()->min;
+
+		for (const Block& block : m_blocks)
+			result = std::min(result, block.min);
+
+		return result;
+	}
+
+	template<Bases::compressible_ct T, size_t block_size>
+	size_t CompressedFixedQueue<T, block_size>::compressedBytes() const
+	{
+		size_t bytes = m_blocks.size() * sizeof(Block);
+
+		for (const Block& block : m_blocks)
+			bytes += block.words.capacity() * sizeof(uint64_t);
+
+		return bytes;
+	}
+
+	template<Bases::compressible_ct T, size_t block_size>
+	void CompressedFixedQueue<T, block_size>::clear()
+	{
+		m_blocks.clear();
+		m_length = 0;
+		m_state = CodecState();
+	}
+
+	template<Bases::compressible_ct T, size_t block_size>
+	typename CompressedFixedQueue<T, block_size>::sum_type CompressedFixedQueue<T, block_size>::addSum(sum_type sum, sum_type value)
+	{
+		if constexpr (std::is_integral_v<T>)
+			return (sum_type)((uint64_t)sum + (uint64_t)value);
+		else
+			return sum + value;
+	}
+
+	template<Bases::compressible_ct T, size_t block_size>
+	void CompressedFixedQueue<T, block_size>::writeBits(Block& block, uint64_t value, int bit_count)
+	{
+		size_t offset = block.bit_count % 64;
+
+		if (bit_count < 64)
+			value &= (uint64_t(1) << bit_count) - 1;
+
+		if (offset == 0)
+			block.words.push_back(0);
+
+		block.words.back() |= value << offset;
+
+		// the value continues in the next word.
+		if (offset + bit_count > 64)
+			block.words.push_back(value >> (64 - offset));
+
+		block.bit_count += bit_count;
+	}
+
+	template<Bases::compressible_ct T, size_t block_size>
+	uint64_t CompressedFixedQueue<T, block_size>::readBits(const Block& block, size_t& bit_pos, int bit_count)
+	{
+		size_t word = bit_pos / 64;
+		size_t offset = bit_pos % 64;
+
+		uint64_t value = block.words[word] >> offset;
+
+		if (offset + bit_count > 64)
+			value |= block.words[word + 1] << (64 - offset);
+
+		bit_pos += bit_count;
+
+		return bit_count < 64 ? value & ((uint64_t(1) << bit_count) - 1) : value;
+	}
+
+	/*
+	INTEGERS:
+	the delta of delta is zigzag encoded, so small negative values are small too, and stored with a prefix for its width.
+	0				0
+	< 2^7			10 + 7 bits
+	< 2^9			110 + 9 bits
+	< 2^12			1110 + 12 bits
+	otherwise		1111 + 64 bits
+
+	FLOATS:
+	0				the xor is 0, the value is repeated.
+	10 + bits		the xor fits between the leading and trailing zeros of the last stored xor, only the bits between them are stored.
+	11 + 6 bits leading zeros + 6 bits length - 1 + bits
+	the prefixes are written from the lowest bit.
+	*/
+	template<Bases::compressible_ct T, size_t block_size>
+	void CompressedFixedQueue<T, block_size>::encode(Block& block, T elem, CodecState& state)
+	{
+		if constexpr (std::is_integral_v<T>)
+		{
+			// the arithmetic is done in uint64_t, so overflowing deltas wrap around instead of being undefined.
+			uint64_t delta = (uint64_t)elem - (uint64_t)state.value;
+			uint64_t dod = delta - state.delta;
+			uint64_t zigzag = (dod << 1) ^ (uint64_t)((int64_t)dod >> 63);
+
+			if (zigzag == 0)
+				writeBits(block, 0b0, 1);
+			else if (zigzag < (1 << 7))
+			{
+				writeBits(block, 0b01, 2);
+				writeBits(block, zigzag, 7);
+			}
+			else if (zigzag < (1 << 9))
+			{
+				writeBits(block, 0b011, 3);
+				writeBits(block, zigzag, 9);
+			}
+			else if (zigzag < (1 << 12))
+			{
+				writeBits(block, 0b0111, 4);
+				writeBits(block, zigzag, 12);
+			}
+			else
+			{
+				writeBits(block, 0b1111, 4);
+				writeBits(block, zigzag, 64);
+			}
+
+			state.delta = delta;
+		}
+		else
+		{
+			bits_type xor_bits = std::bit_cast<bits_type>(elem) ^ std::bit_cast<bits_type>(state.value);
+
+			if (xor_bits == 0)
+				writeBits(block, 0b0, 1);
+			else
+			{
+				int leading = std::countl_zero(xor_bits);
+				int trailing = std::countr_zero(xor_bits);
+
+				if (leading >= state.leading && trailing >= state.trailing)
+				{
+					writeBits(block, 0b01, 2);
+					writeBits(block, xor_bits >> state.trailing, BITS - state.leading - state.trailing);
+				}
+				else
+				{
+					int length = BITS - leading - trailing;
+
+					writeBits(block, 0b11, 2);
+					writeBits(block, leading, 6);
+					writeBits(block, length - 1, 6);
+					writeBits(block, xor_bits >> trailing, length);
+
+					state.leading = leading;
+					state.trailing = trailing;
+				}
+			}
+		}
+
+		state.value = elem;
+	}
+
+	template<Bases::compressible_ct T, size_t block_size>
+	T CompressedFixedQueue<T, block_size>::decode(const Block& block, size_t& bit_pos, CodecState& state)
+	{
+		if constexpr (std::is_integral_v<T>)
+		{
+			int prefix = 0;
+
+			while (prefix < 4 && readBits(block, bit_pos, 1))
+				prefix++;
+
+			constexpr int widths[] = { 0, 7, 9, 12, 64 };
+			uint64_t zigzag = prefix ? readBits(block, bit_pos, widths[prefix]) : 0;
+			uint64_t dod = (zigzag >> 1) ^ (0 - (zigzag & 1));
+
+			state.delta += dod;
+			state.value = (T)((uint64_t)state.value + state.delta);
+		}
+		else
+		{
+			if (!readBits(block, bit_pos, 1))
+				return state.value;
+
+			if (readBits(block, bit_pos, 1))
+			{
+				state.leading = (int)readBits(block, bit_pos, 6);
+				state.trailing = BITS - state.leading - ((int)readBits(block, bit_pos, 6) + 1);
+			}
+
+			bits_type xor_bits = (bits_type)(readBits(block, bit_pos, BITS - state.leading - state.trailing) << state.trailing);
+			state.value = std::bit_cast<T>((bits_type)(std::bit_cast<bits_type>(state.value) ^ xor_bits));
+		}
+
+		return state.value;
+	}
+
+	template<Bases::compressible_ct T, size_t block_size>
+	CompressedFixedQueue<T, block_size>::Iterator::Iterator(ConstFixedQueueIterator<Block> block, size_t remaining)
+		: m_block(block), m_remaining(remaining)
+	{
+		if (m_remaining)
+			loadBlock();
+	}
+
+	template<Bases::compressible_ct T, size_t block_size>
+	typename CompressedFixedQueue<T, block_size>::Iterator& CompressedFixedQueue<T, block_size>::Iterator::operator++()
+	{
+		if (--m_remaining == 0)
+			return *this;
+
+		if (++m_index == m_block->length)
+		{
+			++m_block;
+			loadBlock();
+		}
+		else
+			decode(*m_block, m_bit_pos, m_state);
+
+		return *this;
+	}
+
+	template<Bases::compressible_ct T, size_t block_size>
+	typename CompressedFixedQueue<T, block_size>::Iterator CompressedFixedQueue<T, block_size>::Iterator::operator++(int)
+	{
+		Iterator copy = *this;
+		++*this;
+		return copy;
+	}
+
+	template<Bases::compressible_ct T, size_t block_size>
+	void CompressedFixedQueue<T, block_size>::Iterator::loadBlock()
+	{
+		m_index = 0;
+		m_bit_pos = 0;
+		m_state = CodecState();
+		m_state.value = m_block->first;
+	}
+}
@@ -2,96 +2,314 @@
 #include <cassert>
 #include <numeric>
 #include <limits>
-#include "..\include\FixedQueue.h"
+#include <cstring>
+#include <algorithm>
+#include <utility>
+#include <new>
 
 
 namespace ADS
 {
 	namespace Bases
 	{
-		template<typename T>
-		void FixedQueueBase<T>::push_back(T elem)
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		template<typename... TArgs> requires std::is_constructible_v<T, TArgs...>
+		typename FixedQueueBase<T, TCapacity, TTracker, TOverflow>::emplace_result FixedQueueBase<T, TCapacity, TTracker, TOverflow>::emplace_back(TArgs&&... args)
 		{
+			if (m_size == m_fixed_size)
+			{
+				T& slot = m_data[m_front_index];
+
+				// the front is overwritten, so it is popped from the trackers point of view.
+				// a policy which may drop the element instead only gets to see the front, as it stays in the queue in that case.
+				// otherwise the trackers are notified first, so the policy may move from the front.
+				if constexpr (TOverflow::template rejects<T>)
+				{
+					if (!TOverflow::onOverflow(std::as_const(slot)))
+						return nullptr;
+
+					TTracker::onPop(slot);
+				}
+				else
+				{
+					TTracker::onPop(slot);
+					TOverflow::onOverflow(slot);
+				}
+
+				// a single argument of type T is assigned directly, so a copy can reuse the resources of the overwritten element.
+				// otherwise the element is constructed before the front is overwritten, as the arguments might refer to it.
+				if constexpr (sizeof...(TArgs) == 1 && (std::is_same_v<std::remove_cvref_t<TArgs>, T> && ...))
+					slot = (std::forward<TArgs>(args), ...);
+				else
+					slot = T(std::forward<TArgs>(args)...);
+
+				m_front_index = TCapacity::wrap(m_front_index + 1, m_fixed_size);
 
-			if (m_size < m_fixed_size)
+				TTracker::onPush(slot);
+
+				if constexpr (TOverflow::template rejects<T>)
+					return &slot;
+				else
+					return slot;
+			}
+
+			T* slot = std::construct_at(m_data + projectIndex(m_size), std::forward<TArgs>(args)...);
+			m_size++;
+
+			TTracker::onPush(*slot);
+
+			if constexpr (TOverflow::template rejects<T>)
+				return slot;
+			else
+				return *slot;
+		}
+
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		template<i_iterator_ct<T> TIter>
+		void FixedQueueBase<T, TCapacity, TTracker, TOverflow>::push_back(TIter begin, TIter end)
+		{
+			if constexpr (std::contiguous_iterator<TIter> && std::is_same_v<std::iter_value_t<TIter>, T> && std::is_trivially_copyable_v<T> && bulk_overflow)
 			{
-				m_data[projectIndex(m_size)] = elem;
-				m_size++;
+				pushContiguous(std::to_address(begin), end - begin);
 			}
 			else
 			{
-				m_data[m_front_index] = elem;
-				m_front_index++;
-				m_front_index %= m_fixed_size;
+				for (auto current = begin; current != end; current++)
+					emplace_back(*current);
 			}
 		}
 
-		template<typename T>
-		template<i_iterator_ct<T> TIter>
-		void FixedQueueBase<T>::push_back(TIter begin, TIter end)
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		template<typename TIter>
+		void FixedQueueBase<T, TCapacity, TTracker, TOverflow>::pushMoved(TIter begin, TIter end)
 		{
-			for (auto current = begin; current != end; current++)
-				push_back((T)*current);
+			// moving a trivially copyable element is a copy, and the copying overload can use memcpy
+			if constexpr (std::is_trivially_copyable_v<T>)
+				push_back(begin, end);
+			else
+				push_back(std::make_move_iterator(begin), std::make_move_iterator(end));
 		}
 
-		template<typename T>
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
 		template<typename TOther> requires std::is_convertible_v<TOther, T>
-		void FixedQueueBase<T>::push_back(std::initializer_list<TOther> list)
+		void FixedQueueBase<T, TCapacity, TTracker, TOverflow>::push_back(std::initializer_list<TOther> list)
 		{
-			for (const TOther& elem : list)
-				push_back((T)elem);
+			if constexpr (std::is_same_v<TOther, T> && std::is_trivially_copyable_v<T> && bulk_overflow)
+			{
+				pushContiguous(list.begin(), list.size());
+			}
+			else
+			{
+				for (const TOther& elem : list)
+					emplace_back(elem);
+			}
 		}
 
-		template<typename T>
-		template<typename TOther> requires std::is_convertible_v<TOther, T>
-		void FixedQueueBase<T>::push_back(FixedQueueBase<TOther>& other)
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		template<typename TOther, typename... TOtherParams> requires std::is_convertible_v<TOther, T>
+		void FixedQueueBase<T, TCapacity, TTracker, TOverflow>::push_back(FixedQueueBase<TOther, TOtherParams...>& other)
 		{
-			for (const TOther& elem : other)
+			// other is cleared afterwards, so its elements can be moved from
+			for (TOther& elem : other)
 			{
-				push_back((T)elem);
+				emplace_back(std::move(elem));
 			}
 
 			other.clear();
 		}
 
-		template<typename T>
-		template<typename TOther> requires std::is_convertible_v<TOther, T>
-			void FixedQueueBase<T>::push_back(const FixedQueueBase<TOther>& other)
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		template<typename TOther, typename... TOtherParams> requires std::is_convertible_v<TOther, T>
+			void FixedQueueBase<T, TCapacity, TTracker, TOverflow>::push_back(const FixedQueueBase<TOther, TOtherParams...>& other)
 			{
 				for (const TOther& elem : other)
 				{
-					push_back((T)elem);
+					emplace_back(elem);
 				}
 			}
 
-		template<typename T>
-		void FixedQueueBase<T>::pop_front(size_t elem_count)
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		void FixedQueueBase<T, TCapacity, TTracker, TOverflow>::pop_front(size_t elem_count)
 		{
 			assert(m_size > 0 && elem_count <= length());
 
+			if constexpr (!std::is_same_v<TTracker, NoTracker>)
+				for (size_t i = 0; i < elem_count; i++)
+					TTracker::onPop(operator[](i));
+
+			dropFront(elem_count);
+		}
+
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		void FixedQueueBase<T, TCapacity, TTracker, TOverflow>::pop_front(T* target, size_t elem_count)
+		{
+			assert(elem_count <= length());
+
+			if (elem_count == 0)
+				return;
+
+			// the tracker has to see the elements before they are moved from
+			if constexpr (!std::is_same_v<TTracker, NoTracker>)
+				for (size_t i = 0; i < elem_count; i++)
+					TTracker::onPop(operator[](i));
+
+			// the elements are split into the part before the end of m_data and the part that wrapped around to the start of it.
+			size_t first_count = std::min(elem_count, contiguousFrom(m_front_index));
+
+			if constexpr (std::is_trivially_copyable_v<T>)
+			{
+				std::memcpy(target, m_data + m_front_index, first_count * sizeof(T));
+				std::memcpy(target + first_count, m_data, (elem_count - first_count) * sizeof(T));
+			}
+			else
+			{
+				std::move(m_data + m_front_index, m_data + m_front_index + first_count, target);
+				std::move(m_data, m_data + elem_count - first_count, target + first_count);
+			}
+
+			dropFront(elem_count);
+		}
+
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		std::pair<std::span<T>, std::span<T>> FixedQueueBase<T, TCapacity, TTracker, TOverflow>::reserve(size_t elem_count) requires std::is_trivially_copyable_v<T>
+		{
+			elem_count = std::min(elem_count, m_fixed_size - m_size);
+
+			if (elem_count == 0)
+				return {};
+
+			size_t back_index = projectIndex(m_size);
+			size_t first_count = std::min(elem_count, contiguousFrom(back_index));
+
+			return { std::span<T>(m_data + back_index, first_count), std::span<T>(m_data, elem_count - first_count) };
+		}
+
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		void FixedQueueBase<T, TCapacity, TTracker, TOverflow>::publish(size_t elem_count) requires std::is_trivially_copyable_v<T>
+		{
+			assert(elem_count <= m_fixed_size - m_size);
+
+			m_size += elem_count;
+
+			if constexpr (!std::is_same_v<TTracker, NoTracker>)
+				for (size_t i = m_size - elem_count; i < m_size; i++)
+					TTracker::onPush(operator[](i));
+		}
+
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		std::pair<std::span<T>, std::span<T>> FixedQueueBase<T, TCapacity, TTracker, TOverflow>::peek(size_t elem_count)
+		{
+			auto [first, second] = std::as_const(*this).peek(elem_count);
+
+			return { std::span<T>(const_cast<T*>(first.data()), first.size()), std::span<T>(const_cast<T*>(second.data()), second.size()) };
+		}
+
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		std::pair<std::span<const T>, std::span<const T>> FixedQueueBase<T, TCapacity, TTracker, TOverflow>::peek(size_t elem_count) const
+		{
+			auto [first, second] = spans();
+
+			elem_count = std::min(elem_count, m_size);
+
+			if (elem_count <= first.size())
+				return { first.first(elem_count), std::span<const T>() };
+			else
+				return { first, second.first(elem_count - first.size()) };
+		}
+
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		void FixedQueueBase<T, TCapacity, TTracker, TOverflow>::dropFront(size_t elem_count)
+		{
+			if constexpr (!std::is_trivially_destructible_v<T>)
+				for (size_t i = 0; i < elem_count; i++)
+					std::destroy_at(&operator[](i));
+
 			m_size -= elem_count;
 
-			m_front_index += elem_count;
-			m_front_index %= m_fixed_size;
+			m_front_index = TCapacity::wrap(m_front_index + elem_count, m_fixed_size);
 		}
 
-		template<typename T>
-		T& FixedQueueBase<T>::operator[](size_t index)
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		T& FixedQueueBase<T, TCapacity, TTracker, TOverflow>::operator[](size_t index)
 		{
 			assert(index < m_size);
 			return m_data[projectIndex(index)];
 		}
 
-		template<typename T>
-		T FixedQueueBase<T>::operator[](size_t index) const
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		T FixedQueueBase<T, TCapacity, TTracker, TOverflow>::operator[](size_t index) const
 		{
 			assert(index < m_size);
 			return m_data[projectIndex(index)];
 		}
 
-		template<typename T>
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		std::pair<std::span<T>, std::span<T>> FixedQueueBase<T, TCapacity, TTracker, TOverflow>::spans(size_t offset)
+		{
+			auto [first, second] = std::as_const(*this).spans(offset);
+
+			return { std::span<T>(const_cast<T*>(first.data()), first.size()), std::span<T>(const_cast<T*>(second.data()), second.size()) };
+		}
+
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		std::pair<std::span<const T>, std::span<const T>> FixedQueueBase<T, TCapacity, TTracker, TOverflow>::spans(size_t offset) const
+		{
+			assert(offset <= m_size);
+
+			// number of elements before the end of m_data
+			size_t first_count = std::min(m_size, contiguousFrom(m_front_index));
+
+			if (offset < first_count)
+				return { std::span<const T>(m_data + m_front_index + offset, first_count - offset), std::span<const T>(m_data, m_size - first_count) };
+			else
+				return { std::span<const T>(m_data + offset - first_count, m_size - offset), std::span<const T>() };
+		}
+
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		std::span<T> FixedQueueBase<T, TCapacity, TTracker, TOverflow>::linearize()
+		{
+			// a mirrored buffer is contiguous from any front index, so it is left as is.
+			if (!is_mirrored && m_front_index != 0)
+			{
+				if (m_size == m_fixed_size)
+				{
+					std::rotate(m_data, m_data + m_front_index, m_data + m_fixed_size);
+				}
+				else
+				{
+					// the free slots are uninitialized, so they can not be rotated with the elements.
+					// instead, the elements before the end of m_data are moved down to follow the elements that wrapped around to the start of it,
+					// after which the elements are contiguous from the start of m_data and can be rotated into order.
+					size_t wrapped_count = m_size - std::min(m_size, contiguousFrom(m_front_index));
+					size_t moved_count = m_size - wrapped_count;
+
+					for (size_t i = 0; i < moved_count; i++)
+					{
+						T* target = m_data + wrapped_count + i;
+						T* source = m_data + m_front_index + i;
+
+						// the target is either a free slot, or an element that has already been moved down
+						if (target < m_data + m_front_index)
+							std::construct_at(target, std::move(*source));
+						else
+							*target = std::move(*source);
+					}
+
+					// destroy the moved from elements that were not reused as targets
+					std::destroy(m_data + std::max(m_front_index, m_size), m_data + m_front_index + moved_count);
+
+					std::rotate(m_data, m_data + wrapped_count, m_data + m_size);
+				}
+
+				m_front_index = 0;
+			}
+
+			return std::span<T>(m_data + m_front_index, m_size);
+		}
+
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
 		template<typename TCast> requires std::is_convertible_v<T, TCast>
-		std::vector<TCast> FixedQueueBase<T>::toVector() const
+		std::vector<TCast> FixedQueueBase<T, TCapacity, TTracker, TOverflow>::toVector() const
 		{
 			std::vector<TCast> result;
 			result.reserve(length());
@@ -102,9 +320,9 @@ namespace ADS
 			return result;
 		}
 
-		template<typename T>
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
 		template<typename TCast> requires std::is_convertible_v<T, TCast>
-		std::unique_ptr<TCast> FixedQueueBase<T>::toCarr() const
+		std::unique_ptr<TCast> FixedQueueBase<T, TCapacity, TTracker, TOverflow>::toCarr() const
 		{
 			TCast* carr = new TCast[length()];
 
@@ -115,19 +333,28 @@ namespace ADS
 		}
 
 		
-		template<typename T>
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
 		template<typename TAvg> requires requires(T x) { x + x / x; }
-		T FixedQueueBase<T>::avg()
+		T FixedQueueBase<T, TCapacity, TTracker, TOverflow>::avg()
 		{
+			if constexpr (requires(const TTracker& tracker) { tracker.sum(); })
+				return TTracker::sum() / (TAvg)length();
+
+			if constexpr (SIMD::simd_ct<T> && std::is_same_v<TAvg, T>)
+				return reduceSegments(0, SIMD::sum<T>) / (TAvg)length();
+
 			// standard avrage calculation
 			TAvg sum = std::accumulate(begin(), end(), TAvg(0));
 			return sum / (TAvg)length();
 		}
 
-		template<typename T>
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
 		template<typename TAvg> requires requires(T x) { x + x / x; }
-		T FixedQueueBase<T>::avgHuge()
+		T FixedQueueBase<T, TCapacity, TTracker, TOverflow>::avgHuge()
 		{
+			if constexpr (requires(const TTracker& tracker) { tracker.sum(); })
+				return (T)(TTracker::sum() / (TAvg)length());
+
 			TAvg avg = TAvg(0);
 
 			for (const T& elem : *this)
@@ -139,9 +366,63 @@ namespace ADS
 			return (T) avg;
 		}
 
-		template<typename T>
-		T FixedQueueBase<T>::max(size_t offset)
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		template<typename TFloat>
+		TFloat FixedQueueBase<T, TCapacity, TTracker, TOverflow>::variance() const
 		{
+			if constexpr (requires(const TTracker& tracker) { tracker.trackedVariance(); })
+				return (TFloat)TTracker::trackedVariance();
+
+			if (length() == 0)
+				return TFloat(0);
+
+			auto [first, second] = spans();
+
+			// two passes, as subtracting the mean before squaring is more precise than the sum of squares minus the squared sum.
+			TFloat mean = TFloat(0);
+
+			for (std::span<const T> segment : { first, second })
+				for (const T& elem : segment)
+					mean += (TFloat)elem;
+
+			mean /= (TFloat)length();
+
+			TFloat squared_diff = TFloat(0);
+
+			for (std::span<const T> segment : { first, second })
+				for (const T& elem : segment)
+					squared_diff += ((TFloat)elem - mean) * ((TFloat)elem - mean);
+
+			return squared_diff / (TFloat)length();
+		}
+
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		T FixedQueueBase<T, TCapacity, TTracker, TOverflow>::quantile(double q) const
+		{
+			assert(length() > 0);
+
+			if constexpr (requires(const TTracker& tracker) { tracker.trackedQuantile(q); })
+				return TTracker::trackedQuantile(q);
+
+			size_t rank = QuantileTracker<T>::quantileRank(q, length());
+
+			std::vector<T> sorted = toVector();
+			std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+
+			return sorted[rank];
+		}
+
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		T FixedQueueBase<T, TCapacity, TTracker, TOverflow>::max(size_t offset)
+		{
+			if constexpr (requires(const TTracker& tracker) { tracker.trackedMax(); })
+				if (offset == 0 && length() > 0)
+					return TTracker::trackedMax();
+
+			if constexpr (SIMD::simd_ct<T>)
+				if (length() > offset)
+					return reduceSegments(offset, SIMD::max<T>);
+
 			if (length() > offset)
 				return operator[](iOfMax(offset));
 			else if (std::numeric_limits<T>::is_specialized)
@@ -155,13 +436,29 @@ namespace ADS
 				return T(SIZE_MAX);
 		}
 
-		template<typename T>
-		size_t FixedQueueBase<T>::iOfMax(size_t offset)
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		size_t FixedQueueBase<T, TCapacity, TTracker, TOverflow>::iOfMax(size_t offset)
 		{
+			if constexpr (requires(const TTracker& tracker) { tracker.trackedIOfMax(); })
+				if (offset == 0 && length() > 0)
+					return TTracker::trackedIOfMax();
+
+			if constexpr (SIMD::simd_ct<T>)
+			{
+				if (length() > offset)
+				{
+					size_t max_i = findFrom(offset, reduceSegments(offset, SIMD::max<T>));
+
+					// the maximum can only be missing if it is NaN, in which case the scan below is used instead.
+					if (max_i != SIZE_MAX)
+						return max_i;
+				}
+			}
+
 			if (length() > offset)
 			{
 				size_t i = 0;
-				size_t max_i = 0;
+				size_t max_i = offset;
 				T* max_val = &*(begin() + offset);
 
 				if (begin() + offset != end())
@@ -172,7 +469,7 @@ namespace ADS
 						{
 							// prevent large objects from being copied, so hold a pointer instead.
 							max_val = &*it;
-							max_i = i + 1;
+							max_i = offset + i + 1;
 						}
 
 						i++;
@@ -187,9 +484,17 @@ namespace ADS
 		}
 
 
-		template<typename T>
-		inline T FixedQueueBase<T>::min(size_t offset)
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		inline T FixedQueueBase<T, TCapacity, TTracker, TOverflow>::min(size_t offset)
 		{
+			if constexpr (requires(const TTracker& tracker) { tracker.trackedMin(); })
+				if (offset == 0 && length() > 0)
+					return TTracker::trackedMin();
+
+			if constexpr (SIMD::simd_ct<T>)
+				if (length() > offset)
+					return reduceSegments(offset, SIMD::min<T>);
+
 			if (length() > offset)
 				return operator[](iOfMin(offset));
 			else if (std::numeric_limits<T>::is_specialized)
@@ -203,13 +508,28 @@ namespace ADS
 				return T(SIZE_MAX);
 		}
 		
-		template<typename T>
-		size_t FixedQueueBase<T>::iOfMin(size_t offset)
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		size_t FixedQueueBase<T, TCapacity, TTracker, TOverflow>::iOfMin(size_t offset)
 		{
+			if constexpr (requires(const TTracker& tracker) { tracker.trackedIOfMin(); })
+				if (offset == 0 && length() > 0)
+					return TTracker::trackedIOfMin();
+
+			if constexpr (SIMD::simd_ct<T>)
+			{
+				if (length() > offset)
+				{
+					size_t min_i = findFrom(offset, reduceSegments(offset, SIMD::min<T>));
+
+					if (min_i != SIZE_MAX)
+						return min_i;
+				}
+			}
+
 			if (length() > offset)
 			{
 				size_t i = 0;
-				size_t min_i = 0;
+				size_t min_i = offset;
 				T* min_val = &*(begin() + offset);
 
 				if (begin() + offset != end())
@@ -219,7 +539,7 @@ namespace ADS
 						{
 							// prevent large objects from being copied, so hold a pointer instead.
 							min_val = &*it;
-							min_i = i;
+							min_i = offset + i + 1;
 						}
 
 						i++;
@@ -231,342 +551,477 @@ namespace ADS
 				return SIZE_MAX;
 		}
 
-		template<typename T>
-		void FixedQueueBase<T>::clear()
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		void FixedQueueBase<T, TCapacity, TTracker, TOverflow>::clear()
 		{
+			destroyElements();
+
 			m_size = 0;
 			m_front_index = 0;
+
+			TTracker::onClear();
 		}
 
-		template<typename T>
-		FixedQueueIterator<T> FixedQueueBase<T>::begin()
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		size_t FixedQueueBase<T, TCapacity, TTracker, TOverflow>::projectIndex(size_t index) const
 		{
-			return FixedQueueIterator<T>(m_data + m_front_index, m_data, m_data + m_fixed_size);
+			if constexpr (is_mirrored)
+				return index + m_front_index;
+			else
+				return TCapacity::wrap(index + m_front_index, m_fixed_size);
 		}
 
-		template<typename T>
-		ConstFixedQueueIterator<T> FixedQueueBase<T>::begin() const
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		template<typename TReduce>
+		T FixedQueueBase<T, TCapacity, TTracker, TOverflow>::reduceSegments(size_t offset, TReduce reduce) const
 		{
-			return ConstFixedQueueIterator<T>(m_data + m_front_index, m_data, m_data + m_fixed_size);
+			auto [first, second] = spans(offset);
+
+			T result = reduce(first.data(), first.size());
+
+			if (!second.empty())
+			{
+				T results[2] = { result, reduce(second.data(), second.size()) };
+				result = reduce(results, 2);
+			}
+
+			return result;
 		}
 
-		template<typename T>
-		FixedQueueIterator<T> FixedQueueBase<T>::end()
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		size_t FixedQueueBase<T, TCapacity, TTracker, TOverflow>::findFrom(size_t offset, const T& value) const
 		{
-			return FixedQueueIterator<T>(m_data + (m_front_index + m_size) % m_fixed_size, m_data, m_data + m_fixed_size);
+			auto [first, second] = spans(offset);
+
+			auto first_it = std::find(first.begin(), first.end(), value);
+
+			if (first_it != first.end())
+				return offset + (first_it - first.begin());
+
+			auto second_it = std::find(second.begin(), second.end(), value);
+
+			if (second_it != second.end())
+				return offset + first.size() + (second_it - second.begin());
+
+			return SIZE_MAX;
 		}
 
-		template<typename T>
-		ConstFixedQueueIterator<T> FixedQueueBase<T>::end() const
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		void FixedQueueBase<T, TCapacity, TTracker, TOverflow>::destroyElements()
 		{
-			return ConstFixedQueueIterator<T>(m_data + (m_front_index + m_size) % m_fixed_size, m_data, m_data + m_fixed_size);
+			if constexpr (!std::is_trivially_destructible_v<T>)
+			{
+				auto [first, second] = spans();
+
+				std::destroy(first.begin(), first.end());
+				std::destroy(second.begin(), second.end());
+			}
 		}
 
-		template<typename T>
-		size_t FixedQueueBase<T>::projectIndex(size_t index) const
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		void FixedQueueBase<T, TCapacity, TTracker, TOverflow>::copyElements(const FixedQueueBase& other)
 		{
-			return (index + m_front_index) % m_fixed_size;
+			assert(m_size == 0 && other.m_size <= m_fixed_size);
+
+			m_front_index = 0;
+
+			// the size is increased one element at a time, so the elements constructed so far are destroyed if a copy throws.
+			for (size_t i = 0; i < other.m_size; i++)
+			{
+				std::construct_at(m_data + i, other.m_data[other.projectIndex(i)]);
+				m_size++;
+			}
+
+			TTracker::operator=(other);
+			TOverflow::operator=(other);
 		}
-	}
 
-	template<typename T>
-	FixedQueue<T>::FixedQueue(size_t size)
-		: Bases::FixedQueueBase<T>(new T[size], size) {}
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		void FixedQueueBase<T, TCapacity, TTracker, TOverflow>::moveElements(FixedQueueBase& other)
+		{
+			assert(m_size == 0 && other.m_size <= m_fixed_size);
 
-	// changes the queues maximum size, if there is not enough space to store part of the data, it is deleted.
-		// data is deleted from back to front
-		// que will be reorganized so the queue front is at the array front instead of potentially in the middle of it, when resized
-	template<typename T>
-	void FixedQueue<T>::resize(size_t new_size)
-	{
-		T* new_arr = new T[new_size];
+			m_front_index = 0;
 
-		for (size_t i = 0; i < std::min(m_size, new_size); i++)
+			for (size_t i = 0; i < other.m_size; i++)
+			{
+				std::construct_at(m_data + i, std::move(other.m_data[other.projectIndex(i)]));
+				m_size++;
+			}
+
+			TTracker::operator=(std::move(other));
+			TOverflow::operator=(std::move(other));
+
+			other.clear();
+		}
+
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		void FixedQueueBase<T, TCapacity, TTracker, TOverflow>::retrack()
 		{
-			new_arr[i] = this->operator[](i);
+			TTracker::onClear();
+			TTracker::onResize(m_fixed_size);
+
+			if constexpr (!std::is_same_v<TTracker, NoTracker>)
+				for (size_t i = 0; i < m_size; i++)
+					TTracker::onPush(operator[](i));
 		}
 
-		std::swap(m_data, new_arr);
-		delete[] new_arr;
+		template<typename T, typename TCapacity, typename TTracker, typename TOverflow>
+		void FixedQueueBase<T, TCapacity, TTracker, TOverflow>::pushContiguous(const T* src, size_t count) requires std::is_trivially_copyable_v<T>
+		{
+			// the elements which do not fit are either dropped here, or overwrite the front below.
+			if (m_size + count > m_fixed_size)
+			{
+				TOverflow::onOverflowCount(m_size + count - m_fixed_size);
 
-		m_fixed_size = new_size;
-		// make sure the size of the queue is updated if it is shrunken
-		m_size = std::min(m_fixed_size, m_size);
-		// put the front index to the start of the array
-		m_front_index = 0;
-	}
+				if constexpr (TOverflow::template rejects<T>)
+					count = m_fixed_size - m_size;
+			}
 
-	// FixedQueueIterator
+			if (count == 0)
+				return;
 
-	template<typename T>
-	FixedQueueIterator<T>& FixedQueueIterator<T>::operator++()
-	{
-		m_ptr++;
-		past_self = true;
+			if constexpr (!std::is_same_v<TTracker, NoTracker>)
+			{
+				// notify the tracker in the same order as pushing the elements one by one would.
+				// when the queue is full, element i pops the element m_fixed_size positions before it, which is either an element already in the queue or an earlier element of src.
+				for (size_t i = 0; i < count; i++)
+				{
+					if (m_size + i >= m_fixed_size)
+					{
+						size_t popped_i = m_size + i - m_fixed_size;
+						TTracker::onPop(popped_i < m_size ? operator[](popped_i) : src[popped_i - m_size]);
+					}
 
-		if (m_ptr >= m_q_back)
-			m_ptr = m_q_front;
+					TTracker::onPush(src[i]);
+				}
+			}
 
-		return *this;
+			if (count >= m_fixed_size)
+			{
+				// every element currently in the queue will be overwritten, so just fill m_data from the start.
+				std::memcpy(m_data, src + count - m_fixed_size, m_fixed_size * sizeof(T));
+
+				m_size = m_fixed_size;
+				m_front_index = 0;
+
+				return;
+			}
+
+			size_t back_index = TCapacity::wrap(m_front_index + m_size, m_fixed_size);
+			size_t first_count = std::min(count, contiguousFrom(back_index));
+
+			std::memcpy(m_data + back_index, src, first_count * sizeof(T));
+			std::memcpy(m_data, src + first_count, (count - first_count) * sizeof(T));
+
+			// the number of elements at the front, that were overwritten by the push
+			size_t overwritten = m_size + count > m_fixed_size ? m_size + count - m_fixed_size : 0;
+
+			m_size += count - overwritten;
+			m_front_index = TCapacity::wrap(m_front_index + overwritten, m_fixed_size);
+		}
 	}
 
-	template<typename T>
-	FixedQueueIterator<T> FixedQueueIterator<T>::operator++(int)
+	template<typename T, typename TCapacity, typename TTracker, typename TAlloc, typename TOverflow>
+	FixedQueue<T, TCapacity, TTracker, TAlloc, TOverflow>::FixedQueue(size_t size, const TAlloc& alloc)
+		: Bases::FixedQueueBase<T, TCapacity, TTracker, TOverflow>(nullptr, TCapacity::capacity(size)), m_alloc(alloc)
 	{
-		FixedQueueIterator<T> tmp = *this;
+		// the allocator is a member, so it is only usable once the base has been constructed
+		m_data = allocate(m_fixed_size);
+	}
 
-		++*this;
+	template<typename T, typename TCapacity, typename TTracker, typename TAlloc, typename TOverflow>
+	FixedQueue<T, TCapacity, TTracker, TAlloc, TOverflow>::~FixedQueue()
+	{
+		this->destroyElements();
+		deallocate(m_data, m_fixed_size);
+	}
 
-		return tmp;
+	template<typename T, typename TCapacity, typename TTracker, typename TAlloc, typename TOverflow>
+	FixedQueue<T, TCapacity, TTracker, TAlloc, TOverflow>::FixedQueue(const FixedQueue& other)
+		: FixedQueue(other.m_fixed_size, alloc_traits::select_on_container_copy_construction(other.m_alloc))
+	{
+		this->copyElements(other);
 	}
 
-	template<typename T>
-	FixedQueueIterator<T> FixedQueueIterator<T>::operator+(size_t offset)
+	template<typename T, typename TCapacity, typename TTracker, typename TAlloc, typename TOverflow>
+	FixedQueue<T, TCapacity, TTracker, TAlloc, TOverflow>::FixedQueue(FixedQueue&& other) noexcept
+		: Bases::FixedQueueBase<T, TCapacity, TTracker, TOverflow>(std::move(other)), m_alloc(std::move(other.m_alloc))
 	{
-		FixedQueueIterator<T> result = *this;
+		other.release();
+	}
 
-		result += offset;
+	template<typename T, typename TCapacity, typename TTracker, typename TAlloc, typename TOverflow>
+	FixedQueue<T, TCapacity, TTracker, TAlloc, TOverflow>& FixedQueue<T, TCapacity, TTracker, TAlloc, TOverflow>::operator=(const FixedQueue& other)
+	{
+		if (this != &other)
+			*this = FixedQueue(other);
 
-		return result;
+		return *this;
 	}
 
-	template<typename T>
-	FixedQueueIterator<T>& FixedQueueIterator<T>::operator+=(size_t offset)
+	template<typename T, typename TCapacity, typename TTracker, typename TAlloc, typename TOverflow>
+	FixedQueue<T, TCapacity, TTracker, TAlloc, TOverflow>& FixedQueue<T, TCapacity, TTracker, TAlloc, TOverflow>::operator=(FixedQueue&& other)
+		noexcept(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)
 	{
-		if (offset > 0)
+		if (this == &other)
+			return *this;
+
+		if constexpr (!alloc_traits::propagate_on_container_move_assignment::value && !alloc_traits::is_always_equal::value)
 		{
-			past_self = true;
+			if (m_alloc != other.m_alloc)
+			{
+				// the storage of other can not be freed by m_alloc, so only the elements are moved
+				this->clear();
 
-			size_t diff = m_q_back - m_ptr;
+				if (m_fixed_size != other.m_fixed_size)
+				{
+					deallocate(m_data, m_fixed_size);
+					m_data = nullptr;
+					m_fixed_size = 0;
 
-			// if the distance between the current pointer and the end of the queue memory is less than or equal to offset, it must cycle back to the start of the queue memory.
-			if (diff <= offset)
-				m_ptr = m_q_front + offset - diff;
-			else
-				m_ptr += offset;
+					m_data = allocate(other.m_fixed_size);
+					m_fixed_size = other.m_fixed_size;
+				}
+
+				this->moveElements(other);
+
+				return *this;
+			}
 		}
 
-		return *this;
-	}
+		this->destroyElements();
+		deallocate(m_data, m_fixed_size);
 
-	template<typename T>
-	FixedQueueIterator<T>& FixedQueueIterator<T>::operator--()
-	{
-		m_ptr--;
-		past_self = true;
+		Bases::FixedQueueBase<T, TCapacity, TTracker, TOverflow>::operator=(std::move(other));
 
-		if (m_ptr < m_q_front)
-			m_ptr = m_q_back;
+		if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+			m_alloc = std::move(other.m_alloc);
+
+		other.release();
 
 		return *this;
 	}
 
-	template<typename T>
-	FixedQueueIterator<T> FixedQueueIterator<T>::operator--(int)
+	template<typename T, typename TCapacity, typename TTracker, typename TAlloc, typename TOverflow>
+	T* FixedQueue<T, TCapacity, TTracker, TAlloc, TOverflow>::allocate(size_t size)
 	{
-		FixedQueueIterator<T> tmp = *this;
-
-		--*this;
-
-		return tmp;
+		return std::to_address(alloc_traits::allocate(m_alloc, size));
 	}
 
-	template<typename T>
-	FixedQueueIterator<T> FixedQueueIterator<T>::operator-(size_t offset)
+	template<typename T, typename TCapacity, typename TTracker, typename TAlloc, typename TOverflow>
+	void FixedQueue<T, TCapacity, TTracker, TAlloc, TOverflow>::deallocate(T* data, size_t size)
 	{
-		FixedQueueIterator<T> result = *this;
+		if (data)
+			alloc_traits::deallocate(m_alloc, data, size);
+	}
 
-		result += offset;
+	template<typename T, typename TCapacity, typename TTracker, typename TAlloc, typename TOverflow>
+	void FixedQueue<T, TCapacity, TTracker, TAlloc, TOverflow>::release()
+	{
+		m_data = nullptr;
+		m_fixed_size = 0;
+		m_size = 0;
+		m_front_index = 0;
 
-		return result;
+		this->retrack();
 	}
 
-	template<typename T>
-	FixedQueueIterator<T>& FixedQueueIterator<T>::operator-=(size_t offset)
+	// changes the queues maximum size, if there is not enough space to store part of the data, it is deleted.
+		// data is deleted from back to front
+		// que will be reorganized so the queue front is at the array front instead of potentially in the middle of it, when resized
+	template<typename T, typename TCapacity, typename TTracker, typename TAlloc, typename TOverflow>
+	void FixedQueue<T, TCapacity, TTracker, TAlloc, TOverflow>::resize(size_t new_size)
 	{
-		if (offset > 0)
-		{
-			past_self = true;
+		new_size = TCapacity::capacity(new_size);
 
-			size_t diff = m_ptr - m_q_front;
+		T* new_arr = allocate(new_size);
 
-			// if the distance between the current pointer and the start of the queue memory is less than offset, it must cycle back to the end of the queue memory.
-			if (diff < offset)
-				m_ptr = m_q_back - offset + diff;
-			else
-				m_ptr -= offset;
+		for (size_t i = 0; i < std::min(m_size, new_size); i++)
+		{
+			std::construct_at(new_arr + i, std::move(this->operator[](i)));
 		}
 
-		return *this;
+		this->destroyElements();
+
+		std::swap(m_data, new_arr);
+		deallocate(new_arr, m_fixed_size);
+
+		m_fixed_size = new_size;
+		// make sure the size of the queue is updated if it is shrunken
+		m_size = std::min(m_fixed_size, m_size);
+		// put the front index to the start of the array
+		m_front_index = 0;
+
+		this->retrack();
 	}
 
-	template<typename T>
-	bool FixedQueueIterator<T>::operator==(const FixedQueueIterator<T>& other) const
+	template<typename T, size_t n, typename TTracker, typename TOverflow>
+	SFixedQueue<T, n, TTracker, TOverflow>& SFixedQueue<T, n, TTracker, TOverflow>::operator=(const SFixedQueue& other)
 	{
-		return m_ptr == other.m_ptr && past_self;
+		if (this != &other)
+		{
+			this->clear();
+			this->copyElements(other);
+		}
+
+		return *this;
 	}
 
-	template<typename T>
-	bool FixedQueueIterator<T>::operator!=(const FixedQueueIterator<T>& other) const
+	template<typename T, size_t n, typename TTracker, typename TOverflow>
+	SFixedQueue<T, n, TTracker, TOverflow>& SFixedQueue<T, n, TTracker, TOverflow>::operator=(SFixedQueue&& other)
 	{
-		return !(*this == other);
+		if (this != &other)
+		{
+			this->clear();
+			this->moveElements(other);
+		}
+
+		return *this;
 	}
 
+	// FixedQueueIterator
+
 	template<typename T>
-	typename FixedQueueIterator<T>::reference FixedQueueIterator<T>::operator*()
+	typename FixedQueueIterator<T>::reference FixedQueueIterator<T>::operator*() const
 	{
-		return *m_ptr;
+		return m_data[dataIndex()];
 	}
 
-	// ConstFixedQueueIterator
 	template<typename T>
-	ConstFixedQueueIterator<T>& ConstFixedQueueIterator<T>::operator++()
+	std::pair<std::span<T>, std::span<T>> FixedQueueIterator<T>::segments(const FixedQueueIterator& last) const
 	{
-		m_ptr++;
-		past_self = true;
+		assert(m_index <= last.m_index);
 
-		if (m_ptr >= m_q_back)
-			m_ptr = m_q_front;
+		size_t data_index = dataIndex();
+		size_t count = last.m_index - m_index;
+		size_t first_count = std::min(count, m_capacity - data_index);
 
-		return *this;
+		return { std::span<T>(m_data + data_index, first_count), std::span<T>(m_data, count - first_count) };
 	}
 
 	template<typename T>
-	ConstFixedQueueIterator<T> ConstFixedQueueIterator<T>::operator++(int)
+	size_t FixedQueueIterator<T>::dataIndex() const
 	{
-		ConstFixedQueueIterator<T> tmp = *this;
+		// the front index is less than the capacity and the index is at most the capacity, so a subtraction is enough to wrap it.
+		size_t data_index = m_front_index + m_index;
 
-		++*this;
+		if (data_index >= m_capacity)
+			data_index -= m_capacity;
 
-		return tmp;
+		return data_index;
 	}
 
 	template<typename T>
-	ConstFixedQueueIterator<T> ConstFixedQueueIterator<T>::operator+(size_t offset)
+	typename FixedQueueIterator<T>::reference FixedQueueIterator<T>::operator[](difference_type offset) const
 	{
-		ConstFixedQueueIterator<T> result = *this;
-
-		result += offset;
-
-		return result;
+		return *(*this + offset);
 	}
 
 	template<typename T>
-	ConstFixedQueueIterator<T>& ConstFixedQueueIterator<T>::operator+=(size_t offset)
+	FixedQueueIterator<T>& FixedQueueIterator<T>::operator++()
 	{
-		if (offset > 0)
-		{
-			past_self = true;
-
-			size_t diff = m_q_back - m_ptr;
-
-			// if the distance between the current pointer and the end of the queue memory is less than offset, it must cycle back to the start of the queue memory.
-			if (diff < offset)
-				m_ptr = m_q_front + offset - diff;
-			else
-				m_ptr += offset;
-		}
+		m_index++;
 
 		return *this;
 	}
 
 	template<typename T>
-	ConstFixedQueueIterator<T>& ConstFixedQueueIterator<T>::operator--()
+	FixedQueueIterator<T> FixedQueueIterator<T>::operator++(int)
 	{
-		m_ptr--;
-		past_self = true;
+		FixedQueueIterator<T> tmp = *this;
 
-		if (m_ptr < m_q_front)
-			m_ptr = m_q_back;
+		++*this;
 
-		return *this;
+		return tmp;
 	}
 
 	template<typename T>
-	ConstFixedQueueIterator<T> ConstFixedQueueIterator<T>::operator--(int)
+	FixedQueueIterator<T>& FixedQueueIterator<T>::operator--()
 	{
-		ConstFixedQueueIterator<T> tmp = *this;
+		m_index--;
 
-		--*this;
-
-		return tmp;
+		return *this;
 	}
 
 	template<typename T>
-	ConstFixedQueueIterator<T> ConstFixedQueueIterator<T>::operator-(size_t offset)
+	FixedQueueIterator<T> FixedQueueIterator<T>::operator--(int)
 	{
-		ConstFixedQueueIterator<T> result = *this;
+		FixedQueueIterator<T> tmp = *this;
 
-		result += offset;
+		--*this;
 
-		return result;
+		return tmp;
 	}
 
 	template<typename T>
-	ConstFixedQueueIterator<T>& ConstFixedQueueIterator<T>::operator-=(size_t offset)
+	FixedQueueIterator<T>& FixedQueueIterator<T>::operator+=(difference_type offset)
 	{
-		if (offset > 0)
-		{
-			past_self = true;
-
-			size_t diff = m_ptr - m_q_front;
-
-			// if the distance between the current pointer and the start of the queue memory is less than offset, it must cycle back to the end of the queue memory.
-			if (diff < offset)
-				m_ptr = m_q_back - offset + diff;
-			else
-				m_ptr -= offset;
-		}
+		m_index += offset;
 
 		return *this;
 	}
 
 	template<typename T>
-	bool ConstFixedQueueIterator<T>::operator==(const ConstFixedQueueIterator<T>& other) const
+	FixedQueueIterator<T>& FixedQueueIterator<T>::operator-=(difference_type offset)
 	{
-		return m_ptr == other.m_ptr && past_self;
+		m_index -= offset;
+
+		return *this;
 	}
+}
 
-	template<typename T>
-	bool ConstFixedQueueIterator<T>::operator!=(const ConstFixedQueueIterator<T>& other) const
+template<typename T, typename TVar, typename... TParams> requires (!std::is_same_v<std::ostream, TVar>)
+void operator<<(TVar& target, ADS::Bases::FixedQueueBase<T, TParams...>& queue)
+{
+	if constexpr (std::is_same_v<T, TVar>)
 	{
-		return !(*this == other);
+		queue.pop_front(&target, 1);
 	}
-
-	template<typename T>
-	typename ConstFixedQueueIterator<T>::reference ConstFixedQueueIterator<T>::operator*() const
+	else
 	{
-		return *m_ptr;
+		target = queue.front();
+		queue.pop();
 	}
 }
 
-template<typename T, typename TVar> requires (!std::is_same_v<std::ostream, TVar>)
-void operator<<(TVar& target, ADS::Bases::FixedQueueBase<T>& queue)
-{
-	target = queue.front();
-	queue.pop();
-}
-
-template<typename T, typename TVec>
-void operator<<(std::vector<TVec>& target, ADS::Bases::FixedQueueBase<T>& queue)
+template<typename T, typename TVec, typename... TParams>
+void operator<<(std::vector<TVec>& target, ADS::Bases::FixedQueueBase<T, TParams...>& queue)
 {
 	size_t out_size = std::min(target.size(), queue.length());
-	for (size_t i = 0; i < out_size; i++)
-		target[i] = queue[i];
-	queue.pop_front(out_size);
+
+	// std::vector<bool> packs its elements into bits, so it has no data() to move them into.
+	if constexpr (std::is_same_v<T, TVec> && std::contiguous_iterator<typename std::vector<TVec>::iterator>)
+	{
+		queue.pop_front(target.data(), out_size);
+	}
+	else
+	{
+		for (size_t i = 0; i < out_size; i++)
+			target[i] = queue[i];
+		queue.pop_front(out_size);
+	}
 }
 
-template<typename T, typename TVec, size_t n>
-void operator<<(std::array<TVec, n>& target, ADS::Bases::FixedQueueBase<T>& queue)
+template<typename T, typename TVec, size_t n, typename... TParams>
+void operator<<(std::array<TVec, n>& target, ADS::Bases::FixedQueueBase<T, TParams...>& queue)
 {
 	size_t out_size = std::min(n, queue.length());
-	for (size_t i = 0; i < out_size; i++)
-		target[i] = queue[i];
-	queue.pop_front(out_size);
+
+	if constexpr (std::is_same_v<T, TVec>)
+	{
+		queue.pop_front(target.data(), out_size);
+	}
+	else
+	{
+		for (size_t i = 0; i < out_size; i++)
+			target[i] = queue[i];
+		queue.pop_front(out_size);
+	}
 }
 
-template<typename T>
-std::ostream& operator<<(std::ostream& stream, const ADS::Bases::FixedQueueBase<T>& queue)
+template<typename T, typename... TParams>
+std::ostream& operator<<(std::ostream& stream, const ADS::Bases::FixedQueueBase<T, TParams...>& queue)
 {
 	for (const T& val : queue)
 		stream << val << ' ';
@@ -0,0 +1,74 @@
+#include "FixedQueueAlgorithms.h"
+#include <algorithm>
+#include <numeric>
+
+namespace ADS
+{
+	template<typename T, typename TFunc>
+	TFunc for_each(FixedQueueIterator<T> first, FixedQueueIterator<T> last, TFunc func)
+	{
+		auto [first_part, second_part] = first.segments(last);
+
+		// func is passed on instead of assigned, as lambdas with captures can not be assigned
+		return std::for_each(second_part.begin(), second_part.end(), std::for_each(first_part.begin(), first_part.end(), std::move(func)));
+	}
+
+	template<typename T, typename TOutIter>
+	TOutIter copy(FixedQueueIterator<T> first, FixedQueueIterator<T> last, TOutIter out)
+	{
+		auto [first_part, second_part] = first.segments(last);
+
+		out = std::copy(first_part.begin(), first_part.end(), out);
+		return std::copy(second_part.begin(), second_part.end(), out);
+	}
+
+	template<typename T, typename TValue>
+	void fill(FixedQueueIterator<T> first, FixedQueueIterator<T> last, const TValue& value)
+	{
+		auto [first_part, second_part] = first.segments(last);
+
+		std::fill(first_part.begin(), first_part.end(), value);
+		std::fill(second_part.begin(), second_part.end(), value);
+	}
+
+	template<typename T, typename TOutIter, typename TOp>
+	TOutIter transform(FixedQueueIterator<T> first, FixedQueueIterator<T> last, TOutIter out, TOp op)
+	{
+		auto [first_part, second_part] = first.segments(last);
+
+		out = std::transform(first_part.begin(), first_part.end(), out, op);
+		return std::transform(second_part.begin(), second_part.end(), out, op);
+	}
+
+	template<typename T, typename TInit, typename TOp>
+	TInit accumulate(FixedQueueIterator<T> first, FixedQueueIterator<T> last, TInit init, TOp op)
+	{
+		auto [first_part, second_part] = first.segments(last);
+
+		init = std::accumulate(first_part.begin(), first_part.end(), std::move(init), op);
+		return std::accumulate(second_part.begin(), second_part.end(), std::move(init), op);
+	}
+
+	template<typename T, typename TValue>
+	FixedQueueIterator<T> find(FixedQueueIterator<T> first, FixedQueueIterator<T> last, const TValue& value)
+	{
+		auto [first_part, second_part] = first.segments(last);
+
+		auto found = std::find(first_part.begin(), first_part.end(), value);
+
+		if (found != first_part.end())
+			return first + (found - first_part.begin());
+
+		found = std::find(second_part.begin(), second_part.end(), value);
+
+		return first + first_part.size() + (found - second_part.begin());
+	}
+
+	template<typename T, typename TValue>
+	std::ptrdiff_t count(FixedQueueIterator<T> first, FixedQueueIterator<T> last, const TValue& value)
+	{
+		auto [first_part, second_part] = first.segments(last);
+
+		return std::count(first_part.begin(), first_part.end(), value) + std::count(second_part.begin(), second_part.end(), value);
+	}
+}
@@ -0,0 +1,148 @@
+#include "FixedQueueChannel.h"
+
+namespace ADS
+{
+	template<typename T, typename TCapacity>
+	bool FixedQueueChannel<T, TCapacity>::pushFrom(T& elem)
+	{
+		if (m_closed)
+			return false;
+
+		// a waiting pop means the queue is empty, so the element is handed over directly.
+		if (!m_pop_waiters.empty())
+		{
+			PopAwaiter* waiter = m_pop_waiters.pop();
+			waiter->m_elem.emplace(std::move(elem));
+			waiter->m_handle.resume();
+			return true;
+		}
+
+		if (m_queue.full())
+			return false;
+
+		m_queue.push_back(std::move(elem));
+		return true;
+	}
+
+	template<typename T, typename TCapacity>
+	bool FixedQueueChannel<T, TCapacity>::try_pop(T& target)
+	{
+		std::optional<T> elem;
+		popInto(elem);
+
+		if (!elem)
+			return false;
+
+		target = std::move(*elem);
+		return true;
+	}
+
+	template<typename T, typename TCapacity>
+	void FixedQueueChannel<T, TCapacity>::popInto(std::optional<T>& target)
+	{
+		if (!m_queue.empty())
+		{
+			target.emplace(std::move(m_queue.front()));
+			m_queue.pop_front();
+			admitWaitingPush();
+		}
+		// a channel of size 0 never holds elements, so pops take them directly from the waiting pushes.
+		else if (!m_push_waiters.empty())
+		{
+			PushAwaiter* waiter = m_push_waiters.pop();
+			target.emplace(std::move(waiter->m_elem));
+			waiter->m_pushed = true;
+			waiter->m_handle.resume();
+		}
+	}
+
+	template<typename T, typename TCapacity>
+	void FixedQueueChannel<T, TCapacity>::close()
+	{
+		m_closed = true;
+
+		// the lists are emptied before resuming anyone, as a resumed coroutine may use the channel again.
+		WaitList<PushAwaiter> push_waiters = std::exchange(m_push_waiters, {});
+		WaitList<PopAwaiter> pop_waiters = std::exchange(m_pop_waiters, {});
+
+		while (!push_waiters.empty())
+			push_waiters.pop()->m_handle.resume();
+
+		while (!pop_waiters.empty())
+			pop_waiters.pop()->m_handle.resume();
+	}
+
+	template<typename T, typename TCapacity>
+	void FixedQueueChannel<T, TCapacity>::admitWaitingPush()
+	{
+		if (m_push_waiters.empty())
+			return;
+
+		PushAwaiter* waiter = m_push_waiters.pop();
+		m_queue.push_back(std::move(waiter->m_elem));
+		waiter->m_pushed = true;
+		waiter->m_handle.resume();
+	}
+
+	template<typename T, typename TCapacity>
+	template<typename TAwaiter>
+	void FixedQueueChannel<T, TCapacity>::WaitList<TAwaiter>::push(TAwaiter* awaiter)
+	{
+		awaiter->m_next = nullptr;
+
+		if (back)
+			back->m_next = awaiter;
+		else
+			front = awaiter;
+
+		back = awaiter;
+	}
+
+	template<typename T, typename TCapacity>
+	template<typename TAwaiter>
+	TAwaiter* FixedQueueChannel<T, TCapacity>::WaitList<TAwaiter>::pop()
+	{
+		TAwaiter* awaiter = front;
+		front = awaiter->m_next;
+
+		if (!front)
+			back = nullptr;
+
+		return awaiter;
+	}
+
+	template<typename T, typename TCapacity>
+	bool FixedQueueChannel<T, TCapacity>::PushAwaiter::await_ready()
+	{
+		// a closed channel fails right away, with m_pushed left false.
+		if (m_channel.m_closed)
+			return true;
+
+		// the element is moved from only if the push succeeds, otherwise it waits in the awaiter.
+		m_pushed = m_channel.pushFrom(m_elem);
+
+		return m_pushed;
+	}
+
+	template<typename T, typename TCapacity>
+	void FixedQueueChannel<T, TCapacity>::PushAwaiter::await_suspend(std::coroutine_handle<> handle)
+	{
+		m_handle = handle;
+		m_channel.m_push_waiters.push(this);
+	}
+
+	template<typename T, typename TCapacity>
+	bool FixedQueueChannel<T, TCapacity>::PopAwaiter::await_ready()
+	{
+		m_channel.popInto(m_elem);
+
+		return m_elem || m_channel.m_closed;
+	}
+
+	template<typename T, typename TCapacity>
+	void FixedQueueChannel<T, TCapacity>::PopAwaiter::await_suspend(std::coroutine_handle<> handle)
+	{
+		m_handle = handle;
+		m_channel.m_pop_waiters.push(this);
+	}
+}
@@ -0,0 +1,195 @@
+#include "FixedQueueParallel.h"
+#include <algorithm>
+#include <numeric>
+#include <functional>
+
+namespace ADS
+{
+	namespace Bases
+	{
+		// calls chunk(chunk_first, chunk_last) for consecutive chunks of [first, last) on separate threads, and returns the results in order.
+		// [first, last) must not be empty.
+		template<typename T, typename TChunk>
+		auto parallelChunks(FixedQueueIterator<T> first, FixedQueueIterator<T> last, size_t thread_count, TChunk chunk)
+		{
+			size_t count = last - first;
+			assert(count > 0);
+
+			if (thread_count == 0)
+				thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+			size_t chunk_count = std::min(thread_count, (count + Parallel::MIN_CHUNK_SIZE - 1) / Parallel::MIN_CHUNK_SIZE);
+			chunk_count = std::max<size_t>(chunk_count, 1);
+
+			std::vector<decltype(chunk(first, last))> results(chunk_count);
+
+			{
+				std::vector<std::jthread> threads;
+				threads.reserve(chunk_count - 1);
+
+				// the first count % chunk_count chunks get one extra element
+				auto chunkFirst = [&](size_t i) { return first + (i * (count / chunk_count) + std::min(i, count % chunk_count)); };
+
+				for (size_t i = 1; i < chunk_count; i++)
+					threads.emplace_back([&, i] { results[i] = chunk(chunkFirst(i), chunkFirst(i + 1)); });
+
+				results[0] = chunk(first, chunkFirst(1));
+			}
+
+			return results;
+		}
+
+		// returns the maximum or minimum of the elements and the index of its first occurrence from first, depending on TCompare.
+		template<typename TCompare, typename T>
+		std::pair<std::remove_cv_t<T>, size_t> chunkExtreme(FixedQueueIterator<T> first, FixedQueueIterator<T> last)
+		{
+			using TValue = std::remove_cv_t<T>;
+			auto [first_part, second_part] = first.segments(last);
+
+			if constexpr (SIMD::simd_ct<TValue>)
+			{
+				// find the value with the vectorized kernel, and then its index
+				TValue value = std::is_same_v<TCompare, std::less<>> ? SIMD::max<TValue>(first_part.data(), first_part.size()) : SIMD::min<TValue>(first_part.data(), first_part.size());
+
+				if (!second_part.empty())
+				{
+					TValue second_value = std::is_same_v<TCompare, std::less<>> ? SIMD::max<TValue>(second_part.data(), second_part.size()) : SIMD::min<TValue>(second_part.data(), second_part.size());
+
+					if (TCompare()(value, second_value))
+						value = second_value;
+				}
+
+				size_t index = std::find(first_part.begin(), first_part.end(), value) - first_part.begin();
+
+				if (index == first_part.size())
+					index += std::find(second_part.begin(), second_part.end(), value) - second_part.begin();
+
+				return { value, index };
+			}
+			else
+			{
+				// max_element with std::greater finds the minimum
+				auto extreme = std::max_element(first_part.begin(), first_part.end(), TCompare());
+				std::pair<TValue, size_t> result = { *extreme, size_t(extreme - first_part.begin()) };
+
+				if (!second_part.empty())
+				{
+					auto second_extreme = std::max_element(second_part.begin(), second_part.end(), TCompare());
+
+					if (TCompare()(result.first, *second_extreme))
+						result = { *second_extreme, first_part.size() + (second_extreme - second_part.begin()) };
+				}
+
+				return result;
+			}
+		}
+
+		// combines the chunk results of chunkExtreme into the index of the first extreme element.
+		template<typename TCompare, typename T>
+		std::pair<std::remove_cv_t<T>, size_t> parallelExtreme(FixedQueueIterator<T> first, FixedQueueIterator<T> last, size_t thread_count)
+		{
+			auto results = parallelChunks(first, last, thread_count, [first](FixedQueueIterator<T> chunk_first, FixedQueueIterator<T> chunk_last)
+				{
+					auto result = chunkExtreme<TCompare>(chunk_first, chunk_last);
+					result.second += chunk_first - first;
+					return result;
+				});
+
+			auto result = results[0];
+
+			// only a strictly more extreme value replaces the result, so the first occurrence is kept
+			for (size_t i = 1; i < results.size(); i++)
+				if (TCompare()(result.first, results[i].first))
+					result = results[i];
+
+			return result;
+		}
+	}
+
+	namespace Parallel
+	{
+		template<typename T, typename TInit, typename TOp>
+		TInit reduce(FixedQueueIterator<T> first, FixedQueueIterator<T> last, TInit init, TOp op, size_t thread_count)
+		{
+			if (first == last)
+				return init;
+
+			auto results = Bases::parallelChunks(first, last, thread_count, [&op](FixedQueueIterator<T> chunk_first, FixedQueueIterator<T> chunk_last)
+				{
+					auto [first_part, second_part] = chunk_first.segments(chunk_last);
+
+					// the first part is never empty, so its first element is used as the initial value
+					TInit result = std::reduce(first_part.begin() + 1, first_part.end(), TInit(first_part[0]), op);
+					return std::reduce(second_part.begin(), second_part.end(), std::move(result), op);
+				});
+
+			for (TInit& result : results)
+				init = op(std::move(init), std::move(result));
+
+			return init;
+		}
+
+		template<typename T, std::random_access_iterator TOutIter, typename TOp>
+		TOutIter transform(FixedQueueIterator<T> first, FixedQueueIterator<T> last, TOutIter out, TOp op, size_t thread_count)
+		{
+			if (first == last)
+				return out;
+
+			auto results = Bases::parallelChunks(first, last, thread_count, [&](FixedQueueIterator<T> chunk_first, FixedQueueIterator<T> chunk_last)
+				{
+					auto [first_part, second_part] = chunk_first.segments(chunk_last);
+
+					TOutIter chunk_out = out + (chunk_first - first);
+					chunk_out = std::transform(first_part.begin(), first_part.end(), chunk_out, op);
+					return std::transform(second_part.begin(), second_part.end(), chunk_out, op);
+				});
+
+			return results.back();
+		}
+
+		template<typename TAvg, Bases::fixed_queue_ct TQueue>
+		queue_value_t<TQueue> avg(const TQueue& queue, size_t thread_count)
+		{
+			using T = queue_value_t<TQueue>;
+			using TSum = std::conditional_t<std::is_void_v<TAvg>, T, TAvg>;
+
+			assert(queue.length() > 0);
+
+			auto results = Bases::parallelChunks(queue.begin(), queue.end(), thread_count, [](ConstFixedQueueIterator<T> chunk_first, ConstFixedQueueIterator<T> chunk_last)
+				{
+					auto [first_part, second_part] = chunk_first.segments(chunk_last);
+
+					if constexpr (SIMD::simd_ct<T> && std::is_same_v<TSum, T>)
+						return SIMD::sum<T>(first_part.data(), first_part.size()) + (second_part.empty() ? T(0) : SIMD::sum<T>(second_part.data(), second_part.size()));
+					else
+						return std::accumulate(second_part.begin(), second_part.end(), std::accumulate(first_part.begin(), first_part.end(), TSum(0)));
+				});
+
+			return std::accumulate(results.begin(), results.end(), TSum(0)) / (TSum)queue.length();
+		}
+
+		template<Bases::fixed_queue_ct TQueue>
+		queue_value_t<TQueue> max(const TQueue& queue, size_t thread_count)
+		{
+			return Bases::parallelExtreme<std::less<>>(queue.begin(), queue.end(), thread_count).first;
+		}
+
+		template<Bases::fixed_queue_ct TQueue>
+		queue_value_t<TQueue> min(const TQueue& queue, size_t thread_count)
+		{
+			return Bases::parallelExtreme<std::greater<>>(queue.begin(), queue.end(), thread_count).first;
+		}
+
+		template<Bases::fixed_queue_ct TQueue>
+		size_t iOfMax(const TQueue& queue, size_t thread_count)
+		{
+			return Bases::parallelExtreme<std::less<>>(queue.begin(), queue.end(), thread_count).second;
+		}
+
+		template<Bases::fixed_queue_ct TQueue>
+		size_t iOfMin(const TQueue& queue, size_t thread_count)
+		{
+			return Bases::parallelExtreme<std::greater<>>(queue.begin(), queue.end(), thread_count).second;
+		}
+	}
+}
@@ -0,0 +1,392 @@
+#include "FixedQueueSIMD.h"
+
+#ifdef ADS_SIMD_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// a target region lets the functions inside it use the instructions of the passed instruction set, without compiling the whole program for it.
+// msvc does not need this, as it allows any intrinsic to be used.
+#define ADS_PRAGMA(x) _Pragma(#x)
+
+#if defined(__clang__)
+#define ADS_TARGET_REGION(isa) ADS_PRAGMA(clang attribute push(__attribute__((target(isa))), apply_to = function))
+#define ADS_END_TARGET_REGION ADS_PRAGMA(clang attribute pop)
+#elif defined(__GNUC__)
+#define ADS_TARGET_REGION(isa) ADS_PRAGMA(GCC push_options) ADS_PRAGMA(GCC target(isa))
+#define ADS_END_TARGET_REGION ADS_PRAGMA(GCC pop_options)
+#else
+#define ADS_TARGET_REGION(isa)
+#define ADS_END_TARGET_REGION
+#endif
+
+namespace ADS
+{
+	namespace SIMD
+	{
+		namespace Kernels
+		{
+			enum class Reduction
+			{
+				Max,
+				Min,
+				Sum
+			};
+
+			template<Reduction reduction, typename T>
+			T combine(T a, T b)
+			{
+				if constexpr (reduction == Reduction::Max)
+					return b > a ? b : a;
+				else if constexpr (reduction == Reduction::Min)
+					return b < a ? b : a;
+				else
+					return a + b;
+			}
+
+			// used for the elements that do not fill a whole vector, and when no instruction set is available.
+			template<Reduction reduction, typename T>
+			T reduceScalar(const T* data, size_t count)
+			{
+				T result = reduction == Reduction::Sum ? T(0) : data[0];
+
+				for (size_t i = reduction == Reduction::Sum ? 0 : 1; i < count; i++)
+					result = combine<reduction>(result, data[i]);
+
+				return result;
+			}
+		}
+	}
+}
+
+#ifdef ADS_SIMD_X86
+
+ADS_TARGET_REGION("sse2")
+namespace ADS
+{
+	namespace SIMD
+	{
+		namespace Kernels
+		{
+			namespace SSE2
+			{
+				template<typename T>
+				struct Ops;
+
+				template<>
+				struct Ops<int32_t>
+				{
+					using Vec = __m128i;
+					static constexpr size_t width = 4;
+					static constexpr bool has_compare = true;
+
+					static Vec load(const int32_t* data) { return _mm_loadu_si128((const __m128i*)data); }
+					static void store(int32_t* data, Vec v) { _mm_storeu_si128((__m128i*)data, v); }
+					// sse2 has no 32 bit integer max / min, so select with a comparison mask instead.
+					static Vec max(Vec a, Vec b) { Vec mask = _mm_cmpgt_epi32(a, b); return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b)); }
+					static Vec min(Vec a, Vec b) { Vec mask = _mm_cmplt_epi32(a, b); return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b)); }
+					static Vec add(Vec a, Vec b) { return _mm_add_epi32(a, b); }
+				};
+
+				// sse2 has no 64 bit integer comparison, so only sums are vectorized.
+				template<>
+				struct Ops<int64_t>
+				{
+					using Vec = __m128i;
+					static constexpr size_t width = 2;
+					static constexpr bool has_compare = false;
+
+					static Vec load(const int64_t* data) { return _mm_loadu_si128((const __m128i*)data); }
+					static void store(int64_t* data, Vec v) { _mm_storeu_si128((__m128i*)data, v); }
+					static Vec add(Vec a, Vec b) { return _mm_add_epi64(a, b); }
+				};
+
+				template<>
+				struct Ops<float>
+				{
+					using Vec = __m128;
+					static constexpr size_t width = 4;
+					static constexpr bool has_compare = true;
+
+					static Vec load(const float* data) { return _mm_loadu_ps(data); }
+					static void store(float* data, Vec v) { _mm_storeu_ps(data, v); }
+					static Vec max(Vec a, Vec b) { return _mm_max_ps(a, b); }
+					static Vec min(Vec a, Vec b) { return _mm_min_ps(a, b); }
+					static Vec add(Vec a, Vec b) { return _mm_add_ps(a, b); }
+				};
+
+				template<>
+				struct Ops<double>
+				{
+					using Vec = __m128d;
+					static constexpr size_t width = 2;
+					static constexpr bool has_compare = true;
+
+					static Vec load(const double* data) { return _mm_loadu_pd(data); }
+					static void store(double* data, Vec v) { _mm_storeu_pd(data, v); }
+					static Vec max(Vec a, Vec b) { return _mm_max_pd(a, b); }
+					static Vec min(Vec a, Vec b) { return _mm_min_pd(a, b); }
+					static Vec add(Vec a, Vec b) { return _mm_add_pd(a, b); }
+				};
+
+#include "FixedQueueSIMDKernel.ipp"
+			}
+		}
+	}
+}
+ADS_END_TARGET_REGION
+
+ADS_TARGET_REGION("avx2")
+namespace ADS
+{
+	namespace SIMD
+	{
+		namespace Kernels
+		{
+			namespace AVX2
+			{
+				template<typename T>
+				struct Ops;
+
+				template<>
+				struct Ops<int32_t>
+				{
+					using Vec = __m256i;
+					static constexpr size_t width = 8;
+					static constexpr bool has_compare = true;
+
+					static Vec load(const int32_t* data) { return _mm256_loadu_si256((const __m256i*)data); }
+					static void store(int32_t* data, Vec v) { _mm256_storeu_si256((__m256i*)data, v); }
+					static Vec max(Vec a, Vec b) { return _mm256_max_epi32(a, b); }
+					static Vec min(Vec a, Vec b) { return _mm256_min_epi32(a, b); }
+					static Vec add(Vec a, Vec b) { return _mm256_add_epi32(a, b); }
+				};
+
+				template<>
+				struct Ops<int64_t>
+				{
+					using Vec = __m256i;
+					static constexpr size_t width = 4;
+					static constexpr bool has_compare = true;
+
+					static Vec load(const int64_t* data) { return _mm256_loadu_si256((const __m256i*)data); }
+					static void store(int64_t* data, Vec v) { _mm256_storeu_si256((__m256i*)data, v); }
+					// avx2 has no 64 bit integer max / min, so blend with a comparison mask instead.
+					static Vec max(Vec a, Vec b) { return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b)); }
+					static Vec min(Vec a, Vec b) { return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b)); }
+					static Vec add(Vec a, Vec b) { return _mm256_add_epi64(a, b); }
+				};
+
+				template<>
+				struct Ops<float>
+				{
+					using Vec = __m256;
+					static constexpr size_t width = 8;
+					static constexpr bool has_compare = true;
+
+					static Vec load(const float* data) { return _mm256_loadu_ps(data); }
+					static void store(float* data, Vec v) { _mm256_storeu_ps(data, v); }
+					static Vec max(Vec a, Vec b) { return _mm256_max_ps(a, b); }
+					static Vec min(Vec a, Vec b) { return _mm256_min_ps(a, b); }
+					static Vec add(Vec a, Vec b) { return _mm256_add_ps(a, b); }
+				};
+
+				template<>
+				struct Ops<double>
+				{
+					using Vec = __m256d;
+					static constexpr size_t width = 4;
+					static constexpr bool has_compare = true;
+
+					static Vec load(const double* data) { return _mm256_loadu_pd(data); }
+					static void store(double* data, Vec v) { _mm256_storeu_pd(data, v); }
+					static Vec max(Vec a, Vec b) { return _mm256_max_pd(a, b); }
+					static Vec min(Vec a, Vec b) { return _mm256_min_pd(a, b); }
+					static Vec add(Vec a, Vec b) { return _mm256_add_pd(a, b); }
+				};
+
+#include "FixedQueueSIMDKernel.ipp"
+			}
+		}
+	}
+}
+ADS_END_TARGET_REGION
+
+// gcc reports the undefined vectors used inside its own avx512 intrinsics as maybe uninitialized.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+ADS_TARGET_REGION("avx512f")
+namespace ADS
+{
+	namespace SIMD
+	{
+		namespace Kernels
+		{
+			namespace AVX512
+			{
+				template<typename T>
+				struct Ops;
+
+				template<>
+				struct Ops<int32_t>
+				{
+					using Vec = __m512i;
+					static constexpr size_t width = 16;
+					static constexpr bool has_compare = true;
+
+					static Vec load(const int32_t* data) { return _mm512_loadu_si512(data); }
+					static void store(int32_t* data, Vec v) { _mm512_storeu_si512(data, v); }
+					static Vec max(Vec a, Vec b) { return _mm512_max_epi32(a, b); }
+					static Vec min(Vec a, Vec b) { return _mm512_min_epi32(a, b); }
+					static Vec add(Vec a, Vec b) { return _mm512_add_epi32(a, b); }
+				};
+
+				template<>
+				struct Ops<int64_t>
+				{
+					using Vec = __m512i;
+					static constexpr size_t width = 8;
+					static constexpr bool has_compare = true;
+
+					static Vec load(const int64_t* data) { return _mm512_loadu_si512(data); }
+					static void store(int64_t* data, Vec v) { _mm512_storeu_si512(data, v); }
+					static Vec max(Vec a, Vec b) { return _mm512_max_epi64(a, b); }
+					static Vec min(Vec a, Vec b) { return _mm512_min_epi64(a, b); }
+					static Vec add(Vec a, Vec b) { return _mm512_add_epi64(a, b); }
+				};
+
+				template<>
+				struct Ops<float>
+				{
+					using Vec = __m512;
+					static constexpr size_t width = 16;
+					static constexpr bool has_compare = true;
+
+					static Vec load(const float* data) { return _mm512_loadu_ps(data); }
+					static void store(float* data, Vec v) { _mm512_storeu_ps(data, v); }
+					static Vec max(Vec a, Vec b) { return _mm512_max_ps(a, b); }
+					static Vec min(Vec a, Vec b) { return _mm512_min_ps(a, b); }
+					static Vec add(Vec a, Vec b) { return _mm512_add_ps(a, b); }
+				};
+
+				template<>
+				struct Ops<double>
+				{
+					using Vec = __m512d;
+					static constexpr size_t width = 8;
+					static constexpr bool has_compare = true;
+
+					static Vec load(const double* data) { return _mm512_loadu_pd(data); }
+					static void store(double* data, Vec v) { _mm512_storeu_pd(data, v); }
+					static Vec max(Vec a, Vec b) { return _mm512_max_pd(a, b); }
+					static Vec min(Vec a, Vec b) { return _mm512_min_pd(a, b); }
+					static Vec add(Vec a, Vec b) { return _mm512_add_pd(a, b); }
+				};
+
+#include "FixedQueueSIMDKernel.ipp"
+			}
+		}
+	}
+}
+ADS_END_TARGET_REGION
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif
+
+namespace ADS
+{
+	namespace SIMD
+	{
+		inline InstructionSet instructionSet()
+		{
+			static const InstructionSet instruction_set = []()
+			{
+#if defined(ADS_SIMD_X86) && defined(__GNUC__)
+				__builtin_cpu_init();
+
+				if (__builtin_cpu_supports("avx512f"))
+					return InstructionSet::AVX512;
+				if (__builtin_cpu_supports("avx2"))
+					return InstructionSet::AVX2;
+				if (__builtin_cpu_supports("sse2"))
+					return InstructionSet::SSE2;
+#elif defined(ADS_SIMD_X86) && defined(_MSC_VER)
+				int info[4];
+
+				__cpuid(info, 0);
+				int max_leaf = info[0];
+
+				__cpuid(info, 1);
+				bool sse2 = info[3] & (1 << 26);
+				// the os must save the avx registers on context switches (osxsave + avx), which is checked through xcr0.
+				bool avx = (info[2] & (1 << 27)) && (info[2] & (1 << 28));
+				unsigned long long xcr0 = avx ? _xgetbv(0) : 0;
+
+				if (max_leaf >= 7 && (xcr0 & 0x6) == 0x6)
+				{
+					__cpuidex(info, 7, 0);
+
+					if ((info[1] & (1 << 16)) && (xcr0 & 0xe6) == 0xe6)
+						return InstructionSet::AVX512;
+					if (info[1] & (1 << 5))
+						return InstructionSet::AVX2;
+				}
+
+				if (sse2)
+					return InstructionSet::SSE2;
+#endif
+				return InstructionSet::Scalar;
+			}();
+
+			return instruction_set;
+		}
+
+		namespace Kernels
+		{
+			template<Reduction reduction, typename T>
+			T dispatch(const T* data, size_t count)
+			{
+#ifdef ADS_SIMD_X86
+				switch (instructionSet())
+				{
+				case InstructionSet::AVX512:
+					return AVX512::reduce<reduction>(data, count);
+				case InstructionSet::AVX2:
+					return AVX2::reduce<reduction>(data, count);
+				case InstructionSet::SSE2:
+					return SSE2::reduce<reduction>(data, count);
+				default:
+					break;
+				}
+#endif
+				return reduceScalar<reduction>(data, count);
+			}
+		}
+
+		template<simd_ct T>
+		T max(const T* data, size_t count)
+		{
+			return Kernels::dispatch<Kernels::Reduction::Max>(data, count);
+		}
+
+		template<simd_ct T>
+		T min(const T* data, size_t count)
+		{
+			return Kernels::dispatch<Kernels::Reduction::Min>(data, count);
+		}
+
+		template<simd_ct T>
+		T sum(const T* data, size_t count)
+		{
+			return Kernels::dispatch<Kernels::Reduction::Sum>(data, count);
+		}
+	}
+}
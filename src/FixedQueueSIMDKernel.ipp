@@ -0,0 +1,56 @@
+// generic reduction kernel.
+// included by FixedQueueSIMD.ipp once for every instruction set, inside its namespace and target region,
+// so the kernel is compiled for that instruction set and uses the Ops<T> declared next to it.
+
+template<Reduction reduction, typename TOps>
+typename TOps::Vec combineVec(typename TOps::Vec a, typename TOps::Vec b)
+{
+	if constexpr (reduction == Reduction::Max)
+		return TOps::max(a, b);
+	else if constexpr (reduction == Reduction::Min)
+		return TOps::min(a, b);
+	else
+		return TOps::add(a, b);
+}
+
+template<Reduction reduction, typename T>
+T reduce(const T* data, size_t count)
+{
+	using TOps = Ops<T>;
+	using Vec = typename TOps::Vec;
+	constexpr size_t width = TOps::width;
+
+	if constexpr (reduction != Reduction::Sum && !TOps::has_compare)
+	{
+		return reduceScalar<reduction>(data, count);
+	}
+	else
+	{
+		if (count < 2 * width)
+			return reduceScalar<reduction>(data, count);
+
+		// two accumulators, so consecutive iterations do not wait on each other
+		Vec acc0 = TOps::load(data);
+		Vec acc1 = TOps::load(data + width);
+
+		size_t i = 2 * width;
+
+		for (; i + 2 * width <= count; i += 2 * width)
+		{
+			acc0 = combineVec<reduction, TOps>(acc0, TOps::load(data + i));
+			acc1 = combineVec<reduction, TOps>(acc1, TOps::load(data + i + width));
+		}
+
+		acc0 = combineVec<reduction, TOps>(acc0, acc1);
+
+		T lanes[width];
+		TOps::store(lanes, acc0);
+
+		T result = reduceScalar<reduction>(lanes, width);
+
+		for (; i < count; i++)
+			result = combine<reduction>(result, data[i]);
+
+		return result;
+	}
+}
@@ -0,0 +1,96 @@
+#include "MPMCFixedQueue.h"
+
+namespace ADS
+{
+	template<typename T, typename TCapacity>
+	MPMCFixedQueue<T, TCapacity>::MPMCFixedQueue(size_t size)
+		: m_fixed_size(TCapacity::capacity(std::max<size_t>(size, 2))), m_slots(new Slot[m_fixed_size])
+	{
+		for (size_t i = 0; i < m_fixed_size; i++)
+			m_slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	template<typename T, typename TCapacity>
+	bool MPMCFixedQueue<T, TCapacity>::try_push(const T& elem)
+	{
+		size_t pos = m_push_pos.load(std::memory_order_relaxed);
+
+		while (true)
+		{
+			Slot& slot = m_slots[TCapacity::wrap(pos, m_fixed_size)];
+			size_t sequence = slot.sequence.load(std::memory_order_acquire);
+			std::ptrdiff_t diff = (std::ptrdiff_t)sequence - (std::ptrdiff_t)pos;
+
+			if (diff == 0)
+			{
+				// the slot is free, try to claim the position. on failure pos is updated to the current push position.
+				if (m_push_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					slot.data = elem;
+					slot.sequence.store(pos + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			// the slot still holds the element pushed one lap ago, so the queue is full.
+			else if (diff < 0)
+				return false;
+			// another thread claimed pos, retry with the newest position.
+			else
+				pos = m_push_pos.load(std::memory_order_relaxed);
+		}
+	}
+
+	template<typename T, typename TCapacity>
+	void MPMCFixedQueue<T, TCapacity>::push_back(const T& elem)
+	{
+		while (!try_push(elem))
+			popFront(nullptr);
+	}
+
+	template<typename T, typename TCapacity>
+	bool MPMCFixedQueue<T, TCapacity>::try_pop(T& target)
+	{
+		return popFront(&target);
+	}
+
+	template<typename T, typename TCapacity>
+	bool MPMCFixedQueue<T, TCapacity>::popFront(T* target)
+	{
+		size_t pos = m_pop_pos.load(std::memory_order_relaxed);
+
+		while (true)
+		{
+			Slot& slot = m_slots[TCapacity::wrap(pos, m_fixed_size)];
+			size_t sequence = slot.sequence.load(std::memory_order_acquire);
+			std::ptrdiff_t diff = (std::ptrdiff_t)sequence - (std::ptrdiff_t)(pos + 1);
+
+			if (diff == 0)
+			{
+				if (m_pop_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					// without a target the element stays in the slot, and is assigned over by the next push into it.
+					if (target)
+						*target = std::move(slot.data);
+					// hand the slot to the push one lap ahead
+					slot.sequence.store(pos + m_fixed_size, std::memory_order_release);
+					return true;
+				}
+			}
+			// the element at pos has not been pushed yet, so the queue is empty.
+			else if (diff < 0)
+				return false;
+			else
+				pos = m_pop_pos.load(std::memory_order_relaxed);
+		}
+	}
+
+	template<typename T, typename TCapacity>
+	size_t MPMCFixedQueue<T, TCapacity>::length() const
+	{
+		size_t pop_pos = m_pop_pos.load(std::memory_order_acquire);
+		size_t push_pos = m_push_pos.load(std::memory_order_acquire);
+
+		// the two positions are not loaded at the same time, so a pop may be seen before the push it removed.
+		return push_pos > pop_pos ? std::min(push_pos - pop_pos, m_fixed_size) : 0;
+	}
+}
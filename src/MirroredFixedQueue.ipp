@@ -0,0 +1,84 @@
+#include "MirroredFixedQueue.h"
+
+#include <new>
+#include <numeric>
+#include <atomic>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+namespace ADS
+{
+	template<typename T, typename TTracker> requires std::is_trivially_copyable_v<T>
+	MirroredFixedQueue<T, TTracker>::MirroredFixedQueue(size_t size)
+		: Bases::FixedQueueBase<T, MirroredCapacity, TTracker>(mapMirrored(mirroredSize(size)), mirroredSize(size)) {}
+
+	template<typename T, typename TTracker> requires std::is_trivially_copyable_v<T>
+	MirroredFixedQueue<T, TTracker>::~MirroredFixedQueue()
+	{
+		munmap(m_data, 2 * m_fixed_size * sizeof(T));
+	}
+
+	template<typename T, typename TTracker> requires std::is_trivially_copyable_v<T>
+	size_t MirroredFixedQueue<T, TTracker>::mirroredSize(size_t size)
+	{
+		size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+
+		// the smallest number of elements which fills a whole number of pages
+		size_t unit = std::lcm(page_size, sizeof(T)) / sizeof(T);
+
+		return std::max<size_t>(1, (size + unit - 1) / unit) * unit;
+	}
+
+	template<typename T, typename TTracker> requires std::is_trivially_copyable_v<T>
+	T* MirroredFixedQueue<T, TTracker>::mapMirrored(size_t size)
+	{
+		size_t bytes = size * sizeof(T);
+
+		// the physical pages are stored in an anonymous file, so they can be mapped more than once.
+#if defined(__linux__)
+		int fd = memfd_create("ADS::MirroredFixedQueue", MFD_CLOEXEC);
+#else
+		// shm_open needs a unique name, which is unlinked again right away.
+		static std::atomic<unsigned> counter = 0;
+		std::string name = "/ADS-MFQ-" + std::to_string(getpid()) + "-" + std::to_string(counter++);
+
+		int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+
+		if (fd != -1)
+			shm_unlink(name.c_str());
+#endif
+		if (fd == -1)
+			throw std::bad_alloc();
+
+		if (ftruncate(fd, bytes) != 0)
+		{
+			close(fd);
+			throw std::bad_alloc();
+		}
+
+		// reserve twice the address space, so nothing else can be mapped between the two mappings.
+		char* region = (char*)mmap(nullptr, 2 * bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+		if (region == MAP_FAILED)
+		{
+			close(fd);
+			throw std::bad_alloc();
+		}
+
+		bool mapped = mmap(region, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED
+			&& mmap(region + bytes, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED;
+
+		// the mappings keep the pages alive on their own
+		close(fd);
+
+		if (!mapped)
+		{
+			munmap(region, 2 * bytes);
+			throw std::bad_alloc();
+		}
+
+		return (T*)region;
+	}
+}
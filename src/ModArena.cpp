@@ -18,6 +18,17 @@ namespace ADS
         ptr.m_pos = nullptr;
     }
 
+    void ModArena::free(void* address)
+    {
+        auto info = std::find_if(m_mem_info.begin(), m_mem_info.end(), [address](const MemBlockInfo& info) { return info.start == address; });
+        assert(info != m_mem_info.end());
+
+        // unused memory is kept zero initialized
+        memset(info->start, 0, info->size());
+
+        m_mem_info.erase(info);
+    }
+
     std::pair<byte*, size_t> ModArena::findFreeAddress(size_t size)
     {
 
@@ -26,7 +37,7 @@ namespace ADS
 
         for (const MemBlockInfo& info : m_mem_info)
         {
-            if (size_t(last - info.start) >= size)
+            if (size_t(info.start - last) >= size)
                 return { last, index };
             else
             {
@@ -36,7 +47,7 @@ namespace ADS
         }
 
         // compare to end of arena instead of memory block infront of last
-        if (last - m_arena + m_arena_size >= size) return { last, index };
+        if (size_t(m_arena + m_arena_size - last) >= size) return { last, index };
 
         return { nullptr, NULL };
     }
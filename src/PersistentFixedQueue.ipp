@@ -0,0 +1,169 @@
+#include "PersistentFixedQueue.h"
+
+#include <system_error>
+#include <stdexcept>
+#include <cstring>
+#include <atomic>
+#include <cerrno>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+namespace ADS
+{
+	template<typename T, typename TTracker> requires std::is_trivially_copyable_v<T>
+	PersistentFixedQueue<T, TTracker>::PersistentFixedQueue(const std::string& path, size_t size)
+		: Bases::FixedQueueBase<T, ModCapacity, TTracker>(nullptr, size)
+	{
+		open(path);
+	}
+
+	template<typename T, typename TTracker> requires std::is_trivially_copyable_v<T>
+	PersistentFixedQueue<T, TTracker>::~PersistentFixedQueue()
+	{
+		commit();
+
+		munmap(m_header, m_mapped_bytes);
+	}
+
+	template<typename T, typename TTracker> requires std::is_trivially_copyable_v<T>
+	void PersistentFixedQueue<T, TTracker>::commit(bool flush)
+	{
+		// the elements have to be on disk before a state referring to them
+		if (flush && msync(m_data, m_fixed_size * sizeof(T), MS_SYNC) != 0)
+			throw std::system_error(errno, std::generic_category(), "PersistentFixedQueue failed to flush the elements");
+
+		State& state = m_header->states[(m_generation + 1) % 2];
+
+		state.generation = m_generation + 1;
+		state.front_index = m_front_index;
+		state.size = m_size;
+		state.checksum = checksum(state);
+
+		m_generation++;
+
+		if (flush && msync(m_header, dataOffset(), MS_SYNC) != 0)
+			throw std::system_error(errno, std::generic_category(), "PersistentFixedQueue failed to flush the header");
+	}
+
+	template<typename T, typename TTracker> requires std::is_trivially_copyable_v<T>
+	uint64_t PersistentFixedQueue<T, TTracker>::checksum(const State& state)
+	{
+		// splitmix64 over the fields, so a partially written state is detected
+		uint64_t hash = MAGIC;
+
+		for (uint64_t value : { state.generation, state.front_index, state.size })
+		{
+			hash += value + 0x9E3779B97F4A7C15;
+			hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9;
+			hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EB;
+			hash ^= hash >> 31;
+		}
+
+		return hash;
+	}
+
+	template<typename T, typename TTracker> requires std::is_trivially_copyable_v<T>
+	size_t PersistentFixedQueue<T, TTracker>::dataOffset()
+	{
+		size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+
+		// the elements start on a page boundary, which is aligned for T, and can be flushed separately from the header
+		return (std::max(sizeof(Header), alignof(T)) + page_size - 1) / page_size * page_size;
+	}
+
+	template<typename T, typename TTracker> requires std::is_trivially_copyable_v<T>
+	void PersistentFixedQueue<T, TTracker>::open(const std::string& path)
+	{
+		int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+
+		if (fd == -1)
+			throw std::system_error(errno, std::generic_category(), "PersistentFixedQueue failed to open " + path);
+
+		// closes the file on every path out of this function, the mapping keeps the file alive on its own
+		struct FileCloser { int fd; ~FileCloser() { close(fd); } } closer{ fd };
+
+		struct stat file_stat;
+
+		if (fstat(fd, &file_stat) != 0)
+			throw std::system_error(errno, std::generic_category(), "PersistentFixedQueue failed to stat " + path);
+
+		size_t file_size = dataOffset() + m_fixed_size * sizeof(T);
+		bool created = file_stat.st_size == 0;
+		Header header;
+
+		if (!created)
+		{
+			if ((size_t)file_stat.st_size < sizeof(Header) || pread(fd, &header, sizeof(Header), 0) != (ssize_t)sizeof(Header))
+				throw std::runtime_error("PersistentFixedQueue: " + path + " is too small for the requested size");
+
+			// the magic is written last when a file is created, so a process that crashed after resizing the file but before
+			// finishing the header leaves it without one. nothing was ever committed to such a file, so it is created again.
+			created = header.magic == 0;
+		}
+
+		if (created)
+		{
+			if (ftruncate(fd, file_size) != 0)
+				throw std::system_error(errno, std::generic_category(), "PersistentFixedQueue failed to resize " + path);
+		}
+		else
+		{
+			if ((size_t)file_stat.st_size < file_size)
+				throw std::runtime_error("PersistentFixedQueue: " + path + " is too small for the requested size");
+
+			if (header.magic != MAGIC || header.version != VERSION)
+				throw std::runtime_error("PersistentFixedQueue: " + path + " is not a queue of this version");
+
+			if (header.element_size != sizeof(T) || header.element_alignment != alignof(T) || header.capacity != m_fixed_size)
+				throw std::runtime_error("PersistentFixedQueue: " + path + " does not store the requested size of T");
+		}
+
+		void* mapping = mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+		if (mapping == MAP_FAILED)
+			throw std::system_error(errno, std::generic_category(), "PersistentFixedQueue failed to map " + path);
+
+		m_header = (Header*)mapping;
+		m_mapped_bytes = file_size;
+		m_data = (T*)((char*)mapping + dataOffset());
+
+		if (created)
+		{
+			// the header of a file left behind without a magic may be partly written, so all of it is written again.
+			// the magic is written last, see above.
+			std::memset((void*)m_header, 0, sizeof(Header));
+			m_header->version = VERSION;
+			m_header->element_size = sizeof(T);
+			m_header->element_alignment = alignof(T);
+			m_header->capacity = m_fixed_size;
+			m_header->states[0].checksum = checksum(m_header->states[0]);
+			std::atomic_signal_fence(std::memory_order_release);
+			m_header->magic = MAGIC;
+
+			return;
+		}
+
+		// load the newest state that was completely written
+		const State* newest = nullptr;
+
+		for (const State& state : m_header->states)
+			if (state.checksum == checksum(state) && state.front_index < m_fixed_size && state.size <= m_fixed_size)
+				if (!newest || state.generation > newest->generation)
+					newest = &state;
+
+		if (!newest)
+		{
+			munmap(mapping, file_size);
+			m_header = nullptr;
+			throw std::runtime_error("PersistentFixedQueue: both states of " + path + " are corrupt");
+		}
+
+		m_generation = newest->generation;
+		m_front_index = newest->front_index;
+		m_size = newest->size;
+
+		this->retrack();
+	}
+}
@@ -0,0 +1,105 @@
+#include "SPSCFixedQueue.h"
+
+namespace ADS
+{
+	template<typename T, typename TCapacity>
+	SPSCFixedQueue<T, TCapacity>::SPSCFixedQueue(size_t size)
+		: m_fixed_size(TCapacity::capacity(size)), m_data(new T[TCapacity::capacity(size)]) {}
+
+	template<typename T, typename TCapacity>
+	bool SPSCFixedQueue<T, TCapacity>::try_push(const T& elem)
+	{
+		size_t tail = m_tail.load(std::memory_order_relaxed);
+
+		if (freeSlots(tail, 1) == 0)
+			return false;
+
+		m_data[TCapacity::wrap(tail, m_fixed_size)] = elem;
+		// publish the element to the consumer
+		m_tail.store(tail + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	template<typename T, typename TCapacity>
+	template<Bases::i_iterator_ct<T> TIter>
+	size_t SPSCFixedQueue<T, TCapacity>::try_push(TIter begin, TIter end)
+	{
+		size_t tail = m_tail.load(std::memory_order_relaxed);
+		size_t free_slots = freeSlots(tail, m_fixed_size);
+
+		size_t pushed = 0;
+
+		for (TIter current = begin; current != end && pushed < free_slots; current++)
+		{
+			m_data[TCapacity::wrap(tail + pushed, m_fixed_size)] = (T)*current;
+			pushed++;
+		}
+
+		// publish the whole batch at once
+		if (pushed > 0)
+			m_tail.store(tail + pushed, std::memory_order_release);
+
+		return pushed;
+	}
+
+	template<typename T, typename TCapacity>
+	bool SPSCFixedQueue<T, TCapacity>::try_pop(T& target)
+	{
+		size_t head = m_head.load(std::memory_order_relaxed);
+
+		if (filledSlots(head, 1) == 0)
+			return false;
+
+		target = std::move(m_data[TCapacity::wrap(head, m_fixed_size)]);
+		// hand the slot back to the producer
+		m_head.store(head + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	template<typename T, typename TCapacity>
+	size_t SPSCFixedQueue<T, TCapacity>::try_pop(T* target, size_t elem_count)
+	{
+		size_t head = m_head.load(std::memory_order_relaxed);
+		size_t popped = std::min(elem_count, filledSlots(head, elem_count));
+
+		for (size_t i = 0; i < popped; i++)
+			target[i] = std::move(m_data[TCapacity::wrap(head + i, m_fixed_size)]);
+
+		if (popped > 0)
+			m_head.store(head + popped, std::memory_order_release);
+
+		return popped;
+	}
+
+	template<typename T, typename TCapacity>
+	size_t SPSCFixedQueue<T, TCapacity>::freeSlots(size_t tail, size_t required)
+	{
+		size_t free_slots = m_fixed_size - (tail - m_head_cache);
+
+		if (free_slots < required)
+		{
+			// acquire the slots released by the consumer
+			m_head_cache = m_head.load(std::memory_order_acquire);
+			free_slots = m_fixed_size - (tail - m_head_cache);
+		}
+
+		return free_slots;
+	}
+
+	template<typename T, typename TCapacity>
+	size_t SPSCFixedQueue<T, TCapacity>::filledSlots(size_t head, size_t required)
+	{
+		size_t filled_slots = m_tail_cache - head;
+
+		if (filled_slots < required)
+		{
+			// acquire the elements published by the producer
+			m_tail_cache = m_tail.load(std::memory_order_acquire);
+			filled_slots = m_tail_cache - head;
+		}
+
+		return filled_slots;
+	}
+}
@@ -0,0 +1,315 @@
+#include "SharedFixedQueue.h"
+
+#include <system_error>
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <climits>
+#include <cerrno>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+namespace ADS
+{
+	template<typename T, bool multi_producer, typename TCapacity> requires std::is_trivially_copyable_v<T>
+	SharedFixedQueue<T, multi_producer, TCapacity>::SharedFixedQueue(const std::string& name, size_t size, bool wakeup)
+		: m_name(name), m_owner(true), m_wakeup(wakeup), m_fixed_size(TCapacity::capacity(std::max<size_t>(size, 2)))
+	{
+		int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+
+		if (fd == -1)
+			throw std::system_error(errno, std::generic_category(), "SharedFixedQueue failed to create " + name);
+
+		size_t bytes = slotsOffset() + m_fixed_size * sizeof(Slot);
+
+		try
+		{
+			if (ftruncate(fd, bytes) != 0)
+				throw std::system_error(errno, std::generic_category(), "SharedFixedQueue failed to resize " + name);
+
+			map(fd, bytes);
+		}
+		catch (...)
+		{
+			close(fd);
+			shm_unlink(name.c_str());
+			throw;
+		}
+
+		close(fd);
+
+		// the shared memory is zero filled, so only the non zero fields have to be written
+		std::construct_at(m_header);
+		m_header->magic = MAGIC;
+		m_header->version = VERSION;
+		m_header->element_size = sizeof(T);
+		m_header->element_alignment = alignof(T);
+		m_header->capacity = m_fixed_size;
+		m_header->flags = (multi_producer ? MULTI_PRODUCER_FLAG : 0) | (wakeup ? WAKEUP_FLAG : 0);
+
+		for (size_t i = 0; i < m_fixed_size; i++)
+			std::construct_at(&m_slots[i].sequence, i);
+
+		// publish the initialized queue to attaching processes
+		m_header->ready.store(1, std::memory_order_release);
+	}
+
+	template<typename T, bool multi_producer, typename TCapacity> requires std::is_trivially_copyable_v<T>
+	SharedFixedQueue<T, multi_producer, TCapacity>::SharedFixedQueue(const std::string& name, std::chrono::milliseconds timeout)
+		: m_name(name), m_owner(false)
+	{
+		int fd = shm_open(name.c_str(), O_RDWR, 0);
+
+		if (fd == -1)
+			throw std::system_error(errno, std::generic_category(), "SharedFixedQueue failed to open " + name);
+
+		// closes the shared memory on every path out of the constructor, the mapping keeps it alive on its own
+		struct FileCloser { int fd; ~FileCloser() { close(fd); } } closer{ fd };
+
+		auto deadline = std::chrono::steady_clock::now() + timeout;
+
+		// wait for the creator to resize the shared memory, and then for it to initialize the header
+		struct stat file_stat;
+
+		while (true)
+		{
+			if (fstat(fd, &file_stat) != 0)
+				throw std::system_error(errno, std::generic_category(), "SharedFixedQueue failed to stat " + name);
+
+			if ((size_t)file_stat.st_size >= slotsOffset())
+			{
+				if (!m_header)
+					map(fd, slotsOffset());
+
+				if (m_header->ready.load(std::memory_order_acquire) == 1)
+					break;
+			}
+
+			if (std::chrono::steady_clock::now() >= deadline)
+			{
+				if (m_header)
+					munmap(m_header, m_mapped_bytes);
+
+				throw std::runtime_error("SharedFixedQueue: " + name + " was not initialized in time");
+			}
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		bool same_version = m_header->magic == MAGIC && m_header->version == VERSION;
+		bool same_type = m_header->element_size == sizeof(T) && m_header->element_alignment == alignof(T)
+			&& (bool)(m_header->flags & MULTI_PRODUCER_FLAG) == multi_producer;
+		// wrap of TCapacity is only valid for capacities it would have chosen itself, e.g. a power of 2 for Pow2Capacity
+		bool same_capacity = m_header->capacity >= 2 && TCapacity::capacity(m_header->capacity) == m_header->capacity;
+
+		m_fixed_size = m_header->capacity;
+		m_wakeup = m_header->flags & WAKEUP_FLAG;
+
+		munmap(m_header, m_mapped_bytes);
+		m_header = nullptr;
+
+		if (!same_version)
+			throw std::runtime_error("SharedFixedQueue: " + name + " is not a queue of this version");
+
+		if (!same_type)
+			throw std::runtime_error("SharedFixedQueue: " + name + " is a queue of another type");
+
+		if (!same_capacity)
+			throw std::runtime_error("SharedFixedQueue: " + name + " has a capacity which TCapacity can not wrap");
+
+		map(fd, slotsOffset() + m_fixed_size * sizeof(Slot));
+	}
+
+	template<typename T, bool multi_producer, typename TCapacity> requires std::is_trivially_copyable_v<T>
+	SharedFixedQueue<T, multi_producer, TCapacity>::~SharedFixedQueue()
+	{
+		munmap(m_header, m_mapped_bytes);
+
+		if (m_owner)
+			shm_unlink(m_name.c_str());
+	}
+
+	template<typename T, bool multi_producer, typename TCapacity> requires std::is_trivially_copyable_v<T>
+	bool SharedFixedQueue<T, multi_producer, TCapacity>::remove(const std::string& name)
+	{
+		return shm_unlink(name.c_str()) == 0;
+	}
+
+	template<typename T, bool multi_producer, typename TCapacity> requires std::is_trivially_copyable_v<T>
+	bool SharedFixedQueue<T, multi_producer, TCapacity>::try_push(const T& elem)
+	{
+		uint64_t pos = m_header->push_pos.load(std::memory_order_relaxed);
+
+		while (true)
+		{
+			Slot& slot = m_slots[TCapacity::wrap(pos, m_fixed_size)];
+			uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+			int64_t diff = (int64_t)sequence - (int64_t)pos;
+
+			if (diff == 0)
+			{
+				// a single producer owns the push position, so it does not have to be claimed
+				if constexpr (!multi_producer)
+				{
+					m_header->push_pos.store(pos + 1, std::memory_order_relaxed);
+					break;
+				}
+				else if (m_header->push_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			// the slot still holds the element pushed one lap ago, so the queue is full.
+			else if (diff < 0)
+				return false;
+			else
+				pos = m_header->push_pos.load(std::memory_order_relaxed);
+		}
+
+		Slot& slot = m_slots[TCapacity::wrap(pos, m_fixed_size)];
+		slot.data = elem;
+		slot.sequence.store(pos + 1, std::memory_order_release);
+
+		notify();
+
+		return true;
+	}
+
+	template<typename T, bool multi_producer, typename TCapacity> requires std::is_trivially_copyable_v<T>
+	bool SharedFixedQueue<T, multi_producer, TCapacity>::try_pop(T& target)
+	{
+		// there is only one consumer, so the pop position does not have to be claimed
+		uint64_t pos = m_header->pop_pos.load(std::memory_order_relaxed);
+		Slot& slot = m_slots[TCapacity::wrap(pos, m_fixed_size)];
+
+		if (slot.sequence.load(std::memory_order_acquire) != pos + 1)
+			return false;
+
+		target = slot.data;
+		// hand the slot to the push one lap ahead
+		slot.sequence.store(pos + m_fixed_size, std::memory_order_release);
+		m_header->pop_pos.store(pos + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	template<typename T, bool multi_producer, typename TCapacity> requires std::is_trivially_copyable_v<T>
+	size_t SharedFixedQueue<T, multi_producer, TCapacity>::try_pop(T* target, size_t elem_count)
+	{
+		size_t popped = 0;
+
+		while (popped < elem_count && try_pop(target[popped]))
+			popped++;
+
+		return popped;
+	}
+
+	template<typename T, bool multi_producer, typename TCapacity> requires std::is_trivially_copyable_v<T>
+	void SharedFixedQueue<T, multi_producer, TCapacity>::pop_wait(T& target)
+	{
+		waitUntil(target, std::chrono::steady_clock::time_point::max());
+	}
+
+	template<typename T, bool multi_producer, typename TCapacity> requires std::is_trivially_copyable_v<T>
+	bool SharedFixedQueue<T, multi_producer, TCapacity>::pop_wait_for(T& target, std::chrono::nanoseconds timeout)
+	{
+		return waitUntil(target, std::chrono::steady_clock::now() + timeout);
+	}
+
+	template<typename T, bool multi_producer, typename TCapacity> requires std::is_trivially_copyable_v<T>
+	size_t SharedFixedQueue<T, multi_producer, TCapacity>::length() const
+	{
+		uint64_t pop_pos = m_header->pop_pos.load(std::memory_order_acquire);
+		uint64_t push_pos = m_header->push_pos.load(std::memory_order_acquire);
+
+		// the two positions are not loaded at the same time, so a pop may be seen before the push it removed.
+		return push_pos > pop_pos ? std::min<size_t>(push_pos - pop_pos, m_fixed_size) : 0;
+	}
+
+	template<typename T, bool multi_producer, typename TCapacity> requires std::is_trivially_copyable_v<T>
+	void SharedFixedQueue<T, multi_producer, TCapacity>::map(int fd, size_t bytes)
+	{
+		void* mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+		if (mapping == MAP_FAILED)
+			throw std::system_error(errno, std::generic_category(), "SharedFixedQueue failed to map " + m_name);
+
+		m_header = (Header*)mapping;
+		m_slots = (Slot*)((char*)mapping + slotsOffset());
+		m_mapped_bytes = bytes;
+	}
+
+	template<typename T, bool multi_producer, typename TCapacity> requires std::is_trivially_copyable_v<T>
+	void SharedFixedQueue<T, multi_producer, TCapacity>::notify()
+	{
+#if defined(__linux__)
+		if (!m_wakeup)
+			return;
+
+		// pairs with the fence in waitUntil, either the consumer sees the element or this sees the consumer waiting
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		if (m_header->waiters.load(std::memory_order_relaxed) > 0)
+		{
+			m_header->signal.fetch_add(1, std::memory_order_release);
+			syscall(SYS_futex, (uint32_t*)&m_header->signal, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+		}
+#endif
+	}
+
+	template<typename T, bool multi_producer, typename TCapacity> requires std::is_trivially_copyable_v<T>
+	bool SharedFixedQueue<T, multi_producer, TCapacity>::waitUntil(T& target, std::chrono::steady_clock::time_point deadline)
+	{
+		while (true)
+		{
+			if (try_pop(target))
+				return true;
+
+			auto now = std::chrono::steady_clock::now();
+
+			if (now >= deadline)
+				return false;
+
+#if defined(__linux__)
+			if (m_wakeup)
+			{
+				m_header->waiters.fetch_add(1, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+
+				// a push after this load changes the signal, so the futex does not sleep
+				uint32_t signal = m_header->signal.load(std::memory_order_acquire);
+				bool popped = try_pop(target);
+
+				if (!popped)
+				{
+					timespec timeout;
+					timespec* timeout_ptr = nullptr;
+
+					if (deadline != std::chrono::steady_clock::time_point::max())
+					{
+						auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now);
+						timeout.tv_sec = remaining.count() / 1000000000;
+						timeout.tv_nsec = remaining.count() % 1000000000;
+						timeout_ptr = &timeout;
+					}
+
+					syscall(SYS_futex, (uint32_t*)&m_header->signal, FUTEX_WAIT, signal, timeout_ptr, nullptr, 0);
+				}
+
+				m_header->waiters.fetch_sub(1, std::memory_order_relaxed);
+
+				if (popped)
+					return true;
+
+				continue;
+			}
+#endif
+			std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(deadline - now, std::chrono::microseconds(50)));
+		}
+	}
+}
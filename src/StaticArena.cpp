@@ -15,7 +15,7 @@ namespace ADS
 
         size_t block_size = ptrSize((byte*) address);
 
-        memset((byte*) address - sizeof(size_t), NULL, block_size + 1);
+        memset((byte*) address - sizeof(size_t), NULL, sizeof(size_t) + block_size);
 
         address = nullptr;
     }
@@ -10,7 +10,6 @@ namespace ADS
 
         if (!ptr) return nullptr;
 
-        std::cout << (size_t)m_arena << ',' << (size_t)ptr << ',' << (size_t)(ptr - m_arena) << ',' << m_arena_size << '\n';
         *((size_t*)ptr) = amount * sizeof(T);
         ptr += sizeof(size_t);
 
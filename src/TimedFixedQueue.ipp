@@ -0,0 +1,55 @@
+#include "TimedFixedQueue.h"
+
+namespace ADS
+{
+	template<typename T, typename TCapacity, typename TTracker, typename TClock>
+	TimedFixedQueue<T, TCapacity, TTracker, TClock>::TimedFixedQueue(duration window, size_t size)
+		: m_window(window), m_queue(size), m_timestamps(size)
+	{
+	}
+
+	template<typename T, typename TCapacity, typename TTracker, typename TClock>
+	template<typename... TArgs> requires std::is_constructible_v<T, TArgs...>
+	T& TimedFixedQueue<T, TCapacity, TTracker, TClock>::emplaceAt(time_point timestamp, TArgs&&... args)
+	{
+		assert(m_timestamps.empty() || m_timestamps.back() <= timestamp);
+
+		evict(timestamp);
+
+		// both queues have the same size, so if the element overwrites the front, so does its timestamp.
+		T& elem = m_queue.emplace_back(std::forward<TArgs>(args)...);
+		m_timestamps.push_back(timestamp);
+
+		return elem;
+	}
+
+	template<typename T, typename TCapacity, typename TTracker, typename TClock>
+	size_t TimedFixedQueue<T, TCapacity, TTracker, TClock>::evict(time_point now)
+	{
+		// the timestamps are in order, so the expired elements are all at the front.
+		// only the front is compared, as now - m_window could underflow a clock starting at 0.
+		size_t expired = 0;
+
+		while (expired < m_timestamps.length() && now - m_timestamps[expired] > m_window)
+			expired++;
+
+		if (expired)
+			pop_front(expired);
+
+		return expired;
+	}
+
+	template<typename T, typename TCapacity, typename TTracker, typename TClock>
+	void TimedFixedQueue<T, TCapacity, TTracker, TClock>::pop_front(size_t elem_count)
+	{
+		m_queue.pop_front(elem_count);
+		m_timestamps.pop_front(elem_count);
+	}
+
+	template<typename T, typename TCapacity, typename TTracker, typename TClock>
+	void TimedFixedQueue<T, TCapacity, TTracker, TClock>::clear()
+	{
+		m_queue.clear();
+		m_timestamps.clear();
+	}
+}
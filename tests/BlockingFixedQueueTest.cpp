@@ -0,0 +1,183 @@
+#include "Test.h"
+#include "BlockingFixedQueue.h"
+#include <atomic>
+#include <vector>
+
+using namespace ADS;
+
+using namespace std::chrono_literals;
+
+void testSmallSizes()
+{
+	for (size_t size : { 1, 2 })
+	{
+		BlockingFixedQueue<int> queue(size);
+		ADS_CHECK(queue.size() == size);
+
+		for (int lap = 0; lap < 5; lap++)
+		{
+			for (size_t i = 0; i < size; i++)
+				ADS_CHECK(queue.try_push(lap * 10 + (int)i));
+
+			// a full queue is never overwritten
+			ADS_CHECK(!queue.try_push(-1));
+			ADS_CHECK(!queue.push_wait_for(-1, 1ms));
+			ADS_CHECK(queue.full());
+
+			int value = -1;
+
+			for (size_t i = 0; i < size; i++)
+				ADS_CHECK(queue.try_pop(value) && value == lap * 10 + (int)i);
+
+			ADS_CHECK(!queue.try_pop(value));
+			ADS_CHECK(!queue.pop_wait_for(value, 1ms));
+		}
+	}
+}
+
+void testZeroCount()
+{
+	BlockingFixedQueue<int> queue(4);
+	int target[4];
+
+	// returns right away instead of waiting for a push, whether the queue is empty or not
+	ADS_CHECK(queue.pop_wait(target, 0) == 0);
+	ADS_CHECK(queue.pop_wait_for(target, 0, 1s) == 0);
+
+	queue.push_wait(1);
+	ADS_CHECK(queue.pop_wait(target, 0) == 0);
+	ADS_CHECK(queue.length() == 1);
+	ADS_CHECK(queue.pop_wait(target, 4) == 1 && target[0] == 1);
+}
+
+void testWrapBoundary()
+{
+	BlockingFixedQueue<int> queue(5);
+	int next_push = 0;
+	int next_pop = 0;
+
+	// bulk pushes and pops of every length at every offset of the front
+	for (int round = 0; round < 25; round++)
+	{
+		std::vector<int> batch(round % 5 + 1);
+
+		for (int& value : batch)
+			value = next_push++;
+
+		queue.push_wait(batch.begin(), batch.end());
+		ADS_CHECK(queue.length() == batch.size());
+
+		int popped[5];
+		ADS_CHECK(queue.pop_wait(popped, 5) == batch.size());
+
+		for (size_t i = 0; i < batch.size(); i++)
+			ADS_CHECK(popped[i] == next_pop++);
+	}
+}
+
+void testWakeUp()
+{
+	BlockingFixedQueue<int> queue(1);
+	int value = -1;
+
+	// a consumer sleeping on an empty queue is woken by a push
+	std::thread consumer([&] { queue.pop_wait(value); });
+	std::this_thread::sleep_for(10ms);
+	queue.push_wait(42);
+	consumer.join();
+	ADS_CHECK(value == 42);
+
+	// a producer sleeping on a full queue is woken by a pop
+	queue.push_wait(1);
+	std::thread producer([&] { queue.push_wait(2); });
+	std::this_thread::sleep_for(10ms);
+	ADS_CHECK(queue.try_pop(value) && value == 1);
+	producer.join();
+	ADS_CHECK(queue.try_pop(value) && value == 2);
+}
+
+// producers push their id in the upper bits and an increasing counter in the lower bits, single and in batches.
+// every consumer must see the elements of a producer in order, and every element must be popped exactly once.
+void testStress(size_t size, size_t producers, size_t consumers)
+{
+	constexpr uint64_t per_producer = 20000;
+	BlockingFixedQueue<uint64_t> queue(size);
+
+	std::atomic<uint64_t> remaining = producers * per_producer;
+	std::vector<std::vector<uint64_t>> received(consumers);
+	std::vector<std::thread> threads;
+
+	for (uint64_t p = 0; p < producers; p++)
+	{
+		threads.emplace_back([&, p] {
+			uint64_t batch[3];
+
+			for (uint64_t i = 0; i < per_producer;)
+			{
+				if (i % 2 == 0 || i + 3 > per_producer)
+				{
+					queue.push_wait(p << 32 | i++);
+					continue;
+				}
+
+				for (uint64_t& value : batch)
+					value = p << 32 | i++;
+
+				queue.push_wait(batch, batch + 3);
+			}
+		});
+	}
+
+	for (size_t c = 0; c < consumers; c++)
+	{
+		threads.emplace_back([&, c] {
+			uint64_t batch[4];
+
+			// the timeout lets a consumer notice that the others popped the last elements
+			while (remaining.load() > 0)
+			{
+				size_t popped = queue.pop_wait_for(batch, 4, 10ms);
+				remaining -= popped;
+				received[c].insert(received[c].end(), batch, batch + popped);
+			}
+		});
+	}
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	std::vector<size_t> seen(producers * per_producer, 0);
+	bool ordered = true;
+
+	for (const std::vector<uint64_t>& values : received)
+	{
+		std::vector<int64_t> last(producers, -1);
+
+		for (uint64_t value : values)
+		{
+			uint64_t producer = value >> 32;
+			int64_t counter = (int64_t)(value & 0xffffffff);
+
+			ordered &= counter > last[producer];
+			last[producer] = counter;
+			seen[producer * per_producer + counter]++;
+		}
+	}
+
+	ADS_CHECK(ordered);
+	ADS_CHECK(std::all_of(seen.begin(), seen.end(), [](size_t count) { return count == 1; }));
+	ADS_CHECK(queue.empty());
+}
+
+int main()
+{
+	testSmallSizes();
+	testZeroCount();
+	testWrapBoundary();
+	testWakeUp();
+	testStress(1, 1, 1);
+	testStress(2, 3, 2);
+	testStress(16, 2, 4);
+
+	return Test::result();
+}
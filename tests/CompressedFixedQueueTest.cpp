@@ -0,0 +1,159 @@
+#include "Test.h"
+#include "CompressedFixedQueue.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace ADS;
+
+// the unsigned integer holding the bits of a float
+template<typename T>
+using bits_t = std::conditional_t<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>;
+
+// compares the bits, so NaN payloads and the sign of 0 count as well
+template<typename T>
+bool sameBits(const std::vector<T>& a, const std::vector<T>& b)
+{
+	if (a.size() != b.size())
+		return false;
+
+	for (size_t i = 0; i < a.size(); i++)
+	{
+		if constexpr (std::is_floating_point_v<T>)
+		{
+			if (std::bit_cast<bits_t<T>>(a[i]) != std::bit_cast<bits_t<T>>(b[i]))
+				return false;
+		}
+		else if (a[i] != b[i])
+			return false;
+	}
+
+	return true;
+}
+
+// pushes values into a queue large enough to keep all of them, and decodes them again
+template<typename T, size_t block_size = 8>
+bool roundTrips(const std::vector<T>& values)
+{
+	CompressedFixedQueue<T, block_size> queue(values.size());
+
+	for (T value : values)
+		queue.push_back(value);
+
+	return queue.length() == values.size() && sameBits(std::vector<T>(queue.begin(), queue.end()), values);
+}
+
+template<typename T>
+void testIntegerExtremes()
+{
+	constexpr T lowest = std::numeric_limits<T>::lowest();
+	constexpr T highest = std::numeric_limits<T>::max();
+
+	// deltas and deltas of deltas which overflow T, and every width of the prefix
+	ADS_CHECK(roundTrips<T>({ lowest, highest, lowest, highest, highest, lowest, 0, lowest }));
+
+	std::vector<T> widths;
+
+	for (int64_t value : { 0, 1, 2, 3, 5, 8, 13, 100, 300, 1000, 5000, 4000, 0, 0, 0, 1, 0 })
+		widths.push_back((T)value);
+
+	ADS_CHECK(roundTrips(widths));
+	ADS_CHECK(roundTrips<T>({ highest, (T)(highest - 1), (T)(highest - 3), lowest, (T)(lowest + 64), (T)(lowest + 63) }));
+
+	// a single element, and a block holding only a first element
+	ADS_CHECK(roundTrips<T>({ lowest }));
+	ADS_CHECK((roundTrips<T, 1>({ highest, lowest, 0, highest })));
+
+	std::mt19937_64 rng(sizeof(T));
+	std::vector<T> random(1000);
+
+	for (T& value : random)
+		value = (T)rng();
+
+	ADS_CHECK(roundTrips<T>(random));
+}
+
+template<typename T>
+void testFloatSpecials()
+{
+	using limits = std::numeric_limits<T>;
+
+	// the sign of 0 and the payload of a NaN have to survive, so the xor is never skipped for values which compare equal
+	std::vector<T> specials = { (T)0.0, (T)-0.0, (T)0.0, limits::quiet_NaN(), -limits::quiet_NaN(), limits::signaling_NaN(),
+		limits::infinity(), -limits::infinity(), limits::denorm_min(), -limits::denorm_min(), limits::min(), limits::max(),
+		limits::lowest(), (T)1.0, (T)1.0, (T)1.5, limits::epsilon(), (T)-0.0 };
+
+	ADS_CHECK(roundTrips<T>(specials));
+
+	std::vector<T> payload = { (T)1.0, std::bit_cast<T>(std::bit_cast<bits_t<T>>(limits::quiet_NaN()) | 1), (T)1.0 };
+	ADS_CHECK(roundTrips<T>(payload));
+
+	// slowly changing values reuse the leading and trailing zeros of the last xor
+	std::vector<T> series;
+
+	for (int i = 0; i < 100; i++)
+		series.push_back((T)(20.0 + std::sin(i * 0.1)));
+
+	ADS_CHECK(roundTrips<T>(series));
+	ADS_CHECK((roundTrips<T, 1>(series)));
+}
+
+void testBlocks()
+{
+	CompressedFixedQueue<int, 4> queue(8);
+	std::vector<int> pushed;
+
+	// the ring holds one block more than the size needs, so the front is evicted a block at a time once 12 elements were pushed
+	for (int i = 0; i < 30; i++)
+	{
+		int value = i * i - 10 * i;
+		queue.push_back(value);
+		pushed.push_back(value);
+
+		size_t kept = std::min<size_t>(pushed.size(), 8 + (pushed.size() - 1) % 4 + 1);
+		std::vector<int> expected(pushed.end() - kept, pushed.end());
+
+		ADS_CHECK(std::vector<int>(queue.begin(), queue.end()) == expected);
+		ADS_CHECK(queue.front() == expected.front() && queue.back() == expected.back());
+		ADS_CHECK(queue.min() == *std::min_element(expected.begin(), expected.end()));
+		ADS_CHECK(queue.max() == *std::max_element(expected.begin(), expected.end()));
+	}
+
+	ADS_CHECK(queue.blockCount() == 3 && queue.length() == 10);
+
+	// popBlock evicts the front block, and the next block decodes on its own
+	queue.popBlock();
+	ADS_CHECK(queue.length() == 6 && queue.blockCount() == 2);
+	ADS_CHECK(std::vector<int>(queue.begin(), queue.end()) == std::vector<int>(pushed.end() - 6, pushed.end()));
+	ADS_CHECK(queue.avg() == (24 * 24 - 240 + 25 * 25 - 250 + 26 * 26 - 260 + 27 * 27 - 270 + 28 * 28 - 280 + 29 * 29 - 290) / 6);
+
+	// evicting the back block too leaves the queue empty, and the next push starts a new block
+	queue.popBlock();
+	queue.popBlock();
+	ADS_CHECK(queue.empty() && queue.begin() == queue.end());
+
+	queue.push_back(-7);
+	queue.push_back(-5);
+	ADS_CHECK(std::vector<int>(queue.begin(), queue.end()) == std::vector<int>({ -7, -5 }));
+	ADS_CHECK(queue.avg() == -6);
+
+	queue.clear();
+	ADS_CHECK(queue.empty() && queue.blockCount() == 0);
+}
+
+int main()
+{
+	testIntegerExtremes<int64_t>();
+	testIntegerExtremes<uint64_t>();
+	testIntegerExtremes<int32_t>();
+	testIntegerExtremes<int8_t>();
+	testFloatSpecials<double>();
+	testFloatSpecials<float>();
+	testBlocks();
+
+	return Test::result();
+}
@@ -0,0 +1,201 @@
+#include "Test.h"
+#include "Scheduler.h"
+#include "FixedQueueChannel.h"
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace ADS;
+
+using Test::Task;
+
+// no default constructor, and not copyable
+struct Message
+{
+	explicit Message(int value) : value(std::make_unique<int>(value)) {}
+
+	std::unique_ptr<int> value;
+};
+
+Task produce(FixedQueueChannel<Message>& channel, int first, int count, bool close)
+{
+	for (int i = first; i < first + count; i++)
+		ADS_CHECK(co_await channel.push(Message(i)));
+
+	if (close)
+		channel.close();
+}
+
+Task consume(FixedQueueChannel<Message>& channel, std::vector<int>& received)
+{
+	while (std::optional<Message> message = co_await channel.pop())
+		received.push_back(*message->value);
+}
+
+void testSizes()
+{
+	// size 0 hands every element from a push to a pop directly, sizes 1 and 2 wrap the queue on every few elements
+	for (size_t size : { 0, 1, 2 })
+	{
+		FixedQueueChannel<Message> channel(size);
+		std::vector<int> received;
+
+		Test::Scheduler scheduler;
+
+		scheduler.spawn(produce(channel, 0, 10, true));
+		ADS_CHECK(!scheduler.run());
+		ADS_CHECK(channel.length() == size);
+
+		scheduler.spawn(consume(channel, received));
+		ADS_CHECK(scheduler.run());
+		ADS_CHECK(received == std::vector<int>({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+	}
+}
+
+void testWaitOrder()
+{
+	FixedQueueChannel<Message> channel(1);
+	std::vector<int> first;
+	std::vector<int> second;
+
+	Test::Scheduler scheduler;
+
+	// waiting pops are resumed in the order they started waiting
+	scheduler.spawn(consume(channel, first));
+	scheduler.spawn(consume(channel, second));
+	scheduler.spawn(produce(channel, 0, 4, true));
+
+	ADS_CHECK(scheduler.run());
+	ADS_CHECK(first == std::vector<int>({ 0, 2 }));
+	ADS_CHECK(second == std::vector<int>({ 1, 3 }));
+
+	// waiting pushes too
+	FixedQueueChannel<Message> full(1);
+	std::vector<int> received;
+
+	Test::Scheduler full_scheduler;
+
+	ADS_CHECK(full.try_push(Message(-1)));
+	full_scheduler.spawn(produce(full, 0, 2, false));
+	full_scheduler.spawn(produce(full, 10, 2, false));
+	full_scheduler.spawn(consume(full, received));
+
+	// only the consumer is left waiting for more
+	ADS_CHECK(!full_scheduler.run());
+	full.close();
+
+	ADS_CHECK(full_scheduler.run());
+	ADS_CHECK(received == std::vector<int>({ -1, 0, 10, 1, 11 }));
+}
+
+void testClose()
+{
+	FixedQueueChannel<int> channel(0);
+	Test::Scheduler scheduler;
+	bool pushed = true;
+
+	auto push = [&]() -> Task { pushed = co_await channel.push(1); };
+	scheduler.spawn(push());
+	ADS_CHECK(!scheduler.run());
+
+	// close resumes the waiting push, which fails
+	channel.close();
+	ADS_CHECK(scheduler.run() && !pushed);
+
+	int value;
+	ADS_CHECK(!channel.try_push(2));
+	ADS_CHECK(!channel.try_pop(value));
+
+	// the elements left in a closed channel can still be popped
+	FixedQueueChannel<int> buffered(4);
+	ADS_CHECK(buffered.try_push(1) && buffered.try_push(2));
+	buffered.close();
+	ADS_CHECK(!buffered.try_push(3));
+
+	std::vector<std::optional<int>> popped;
+	auto pop_all = [&]() -> Task {
+		for (int i = 0; i < 3; i++)
+			popped.push_back(co_await buffered.pop());
+	};
+
+	scheduler.spawn(pop_all());
+	ADS_CHECK(scheduler.run());
+	ADS_CHECK(popped == std::vector<std::optional<int>>({ 1, 2, std::nullopt }));
+}
+
+// many producers and consumers interleaved by the scheduler, yielding at random points.
+// every consumer must see the elements of a producer in order, and every element must be popped exactly once.
+void testStress(size_t size, int producers, int consumers)
+{
+	constexpr int per_producer = 2000;
+
+	FixedQueueChannel<int> channel(size);
+	Test::Scheduler scheduler;
+	std::mt19937 rng(size);
+	std::vector<std::vector<int>> received(consumers);
+	int producers_left = producers;
+
+	auto produce = [&](int id) -> Task {
+		for (int i = 0; i < per_producer; i++)
+		{
+			ADS_CHECK(co_await channel.push(id * per_producer + i));
+
+			if (rng() % 3 == 0)
+				co_await scheduler.yield();
+		}
+
+		if (--producers_left == 0)
+			channel.close();
+	};
+
+	auto consume = [&](int id) -> Task {
+		while (std::optional<int> value = co_await channel.pop())
+		{
+			received[id].push_back(*value);
+
+			if (rng() % 3 == 0)
+				co_await scheduler.yield();
+		}
+	};
+
+	for (int i = 0; i < std::max(producers, consumers); i++)
+	{
+		if (i < consumers)
+			scheduler.spawn(consume(i));
+		if (i < producers)
+			scheduler.spawn(produce(i));
+	}
+
+	ADS_CHECK(scheduler.run());
+
+	std::vector<int> seen(producers * per_producer, 0);
+	bool ordered = true;
+
+	for (const std::vector<int>& values : received)
+	{
+		std::vector<int> last(producers, -1);
+
+		for (int value : values)
+		{
+			ordered &= value > last[value / per_producer];
+			last[value / per_producer] = value;
+			seen[value]++;
+		}
+	}
+
+	ADS_CHECK(ordered);
+	ADS_CHECK(std::all_of(seen.begin(), seen.end(), [](int count) { return count == 1; }));
+}
+
+int main()
+{
+	testSizes();
+	testWaitOrder();
+	testClose();
+	testStress(0, 3, 2);
+	testStress(1, 4, 4);
+	testStress(7, 2, 5);
+
+	return Test::result();
+}
@@ -0,0 +1,123 @@
+#include "Test.h"
+#include "FixedQueue.h"
+#include "PersistentFixedQueue.h"
+#include <filesystem>
+#include <numeric>
+#include <vector>
+#include <unistd.h>
+
+using namespace ADS;
+
+template<typename TQueue>
+std::vector<int> elements(const TQueue& queue)
+{
+	return std::vector<int>(queue.begin(), queue.end());
+}
+
+// writes next, next + 1, ... into the reserved slots and returns how many there were
+size_t fill(std::pair<std::span<int>, std::span<int>> slots, int next)
+{
+	std::iota(slots.first.begin(), slots.first.end(), next);
+	std::iota(slots.second.begin(), slots.second.end(), next + (int)slots.first.size());
+
+	return slots.first.size() + slots.second.size();
+}
+
+void testWrapPoint()
+{
+	FixedQueue<int, ModCapacity, SumTracker<long>> queue(5);
+
+	// moves the back to the last slot of the buffer
+	queue.push_back({ -1, -2, -3, -4 });
+	queue.pop_front(4);
+
+	auto slots = queue.reserve(4);
+	ADS_CHECK(slots.first.size() == 1 && slots.second.size() == 3);
+	ADS_CHECK(fill(slots, 0) == 4);
+
+	// the reserved slots are not part of the queue until they are published
+	ADS_CHECK(queue.empty());
+
+	queue.publish(4);
+	ADS_CHECK(elements(queue) == std::vector<int>({ 0, 1, 2, 3 }));
+	ADS_CHECK(queue.sum() == 6);
+
+	// peek splits at the same point
+	auto [first, second] = queue.peek(10);
+	ADS_CHECK(first.size() == 1 && second.size() == 3);
+	ADS_CHECK(first[0] == 0 && second[2] == 3);
+
+	queue.consume(3);
+	ADS_CHECK(elements(queue) == std::vector<int>({ 3 }));
+	ADS_CHECK(queue.sum() == 3);
+}
+
+void testMoreThanFree()
+{
+	FixedQueue<int> queue(4);
+	queue.push_back({ 1, 2, 3 });
+
+	// only the free slots are returned, nothing is overwritten
+	auto slots = queue.reserve(10);
+	ADS_CHECK(fill(slots, 4) == 1);
+	queue.publish(1);
+	ADS_CHECK(elements(queue) == std::vector<int>({ 1, 2, 3, 4 }));
+
+	slots = queue.reserve(1);
+	ADS_CHECK(slots.first.empty() && slots.second.empty());
+
+	// peek and consume are limited to the length in the same way
+	auto [first, second] = queue.peek(10);
+	ADS_CHECK(first.size() + second.size() == 4);
+}
+
+void testZeroCount()
+{
+	FixedQueue<int, ModCapacity, SumTracker<long>> queue(3);
+	queue.push_back({ 1, 2 });
+
+	auto slots = queue.reserve(0);
+	ADS_CHECK(slots.first.empty() && slots.second.empty());
+
+	queue.publish(0);
+	queue.consume(0);
+	ADS_CHECK(elements(queue) == std::vector<int>({ 1, 2 }));
+	ADS_CHECK(queue.sum() == 3);
+
+	auto [first, second] = queue.peek(0);
+	ADS_CHECK(first.empty() && second.empty());
+}
+
+void testPersistent()
+{
+	std::string path = (std::filesystem::temp_directory_path() / ("ADS-FixedQueueInPlaceTest-" + std::to_string(getpid()))).string();
+	std::filesystem::remove(path);
+
+	{
+		PersistentFixedQueue<int> queue(path, 4);
+		queue.push_back({ -1, -2, -3 });
+		queue.pop_front(3);
+
+		// publish pushes the reserved slots, and commit makes them durable, the two do not share a name
+		ADS_CHECK(fill(queue.reserve(4), 10) == 4);
+		queue.publish(4);
+		queue.commit();
+
+		queue.consume(1);
+	}
+
+	PersistentFixedQueue<int> queue(path, 4);
+	ADS_CHECK(elements(queue) == std::vector<int>({ 11, 12, 13 }));
+
+	std::filesystem::remove(path);
+}
+
+int main()
+{
+	testWrapPoint();
+	testMoreThanFree();
+	testZeroCount();
+	testPersistent();
+
+	return Test::result();
+}
@@ -0,0 +1,113 @@
+#include "Test.h"
+#include "FixedQueue.h"
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace ADS;
+
+static std::vector<std::string> spilled;
+
+// the sum, minimum and maximum kept by the trackers must match the elements actually in the queue
+template<typename TQueue>
+bool trackersMatch(TQueue& queue)
+{
+	std::vector<int> elements(queue.begin(), queue.end());
+
+	return queue.sum() == std::accumulate(elements.begin(), elements.end(), 0L)
+		&& queue.min() == *std::min_element(elements.begin(), elements.end())
+		&& queue.max() == *std::max_element(elements.begin(), elements.end());
+}
+
+void testMoveSpill()
+{
+	using Spill = CallbackOverflow<decltype([](std::string& oldest) { spilled.push_back(std::move(oldest)); })>;
+	FixedQueue<std::string, ModCapacity, QuantileTracker<std::string>, std::allocator<std::string>, Spill> queue(3);
+
+	// the tracker has to remove the front before the callback moves it away, or it looks for an empty string
+	for (int i = 0; i < 50; i++)
+		queue.push(std::to_string(100 + i));
+
+	ADS_CHECK(spilled.size() == 47 && spilled.front() == "100" && spilled.back() == "146");
+	ADS_CHECK(queue.overwritten() == 47);
+	ADS_CHECK(queue.quantile(0.0) == "147" && queue.quantile(1.0) == "149");
+
+	// the bulk push calls the callback for every overwritten element
+	queue.push(std::vector<std::string>{ "150", "151" });
+	ADS_CHECK(spilled.size() == 49 && spilled.back() == "148");
+	ADS_CHECK(queue.quantile(0.0) == "149");
+}
+
+void testMutatingCallback()
+{
+	using Clobber = CallbackOverflow<decltype([](int& oldest) { oldest = -1000; })>;
+	FixedQueue<int, ModCapacity, Trackers<SumTracker<long>, MinMaxTracker<int>>, std::allocator<int>, Clobber> queue(3);
+
+	for (int i = 0; i < 50; i++)
+	{
+		queue.push(i);
+		ADS_CHECK(trackersMatch(queue));
+	}
+
+	ADS_CHECK(queue.sum() == 144 && queue.min() == 47 && queue.max() == 49);
+
+	queue.push(std::vector<int>{ 1, 2 });
+	ADS_CHECK(trackersMatch(queue));
+}
+
+void testRejectingCallback()
+{
+	using KeepEven = CallbackOverflow<decltype([](const int& oldest) { return oldest % 2 != 0; })>;
+	FixedQueue<int, ModCapacity, Trackers<SumTracker<long>, MinMaxTracker<int>>, std::allocator<int>, KeepEven> queue(2);
+
+	queue.push(2);
+	queue.push(3);
+
+	// an even front is kept, and the trackers never see the dropped elements
+	ADS_CHECK(queue.emplace_back(100) == nullptr);
+	ADS_CHECK(queue.rejected() == 1 && queue.overwritten() == 0);
+	ADS_CHECK(queue.sum() == 5 && queue.max() == 3 && trackersMatch(queue));
+
+	int elements[] = { -5, 200 };
+	queue.push(elements, elements + 2);
+	ADS_CHECK(queue.rejected() == 3 && queue.front() == 2 && queue.back() == 3);
+	ADS_CHECK(trackersMatch(queue));
+
+	// an odd front is overwritten
+	queue.pop_front();
+	queue.push(4);
+	ADS_CHECK(queue.front() == 3 && queue.back() == 4);
+
+	int* pushed = queue.emplace_back(6);
+	ADS_CHECK(pushed && *pushed == 6);
+	ADS_CHECK(queue.overwritten() == 1 && queue.front() == 4);
+	ADS_CHECK(queue.sum() == 10 && queue.min() == 4 && trackersMatch(queue));
+}
+
+void testCounters()
+{
+	FixedQueue<int, ModCapacity, SumTracker<long>, std::allocator<int>, RejectOverflow> rejecting(3);
+	rejecting.push({ 1, 2, 3, 4, 5 });
+	ADS_CHECK(rejecting.rejected() == 2 && rejecting.back() == 3 && rejecting.sum() == 6);
+
+	SFixedQueue<int, 4, SumTracker<long>, CountOverwriteOverflow> overwriting;
+
+	for (int i = 0; i < 10; i++)
+		overwriting.push(i);
+
+	ADS_CHECK(overwriting.overwritten() == 6 && overwriting.front() == 6 && overwriting.sum() == 30);
+
+	overwriting.push(std::vector<int>{ 1, 2, 3, 4, 5, 6 });
+	ADS_CHECK(overwriting.overwritten() == 12 && overwriting.front() == 3 && overwriting.sum() == 18);
+}
+
+int main()
+{
+	testMoveSpill();
+	testMutatingCallback();
+	testRejectingCallback();
+	testCounters();
+
+	return Test::result();
+}
@@ -0,0 +1,55 @@
+#include "Test.h"
+#include "FixedQueue.h"
+#include <array>
+#include <vector>
+
+using namespace ADS;
+
+void testDrainIntoVector()
+{
+	FixedQueue<int> queue(4);
+	queue.push_back({ 1, 2, 3, 4, 5 });
+
+	// only as many elements as the vector holds are popped
+	std::vector<int> target(3);
+	target << queue;
+	ADS_CHECK(target == std::vector<int>({ 2, 3, 4 }));
+	ADS_CHECK(queue.length() == 1 && queue.front() == 5);
+
+	// converted element by element
+	std::vector<double> converted(2, -1.0);
+	converted << queue;
+	ADS_CHECK(converted == std::vector<double>({ 5.0, -1.0 }));
+	ADS_CHECK(queue.empty());
+}
+
+void testDrainIntoBitVector()
+{
+	FixedQueue<bool> queue(3);
+	queue.push_back({ true, false, true, true });
+
+	std::vector<bool> target(2);
+	target << queue;
+	ADS_CHECK(target == std::vector<bool>({ false, true }));
+	ADS_CHECK(queue.length() == 1 && queue.front());
+}
+
+void testDrainIntoArray()
+{
+	FixedQueue<int> queue(3);
+	queue.push_back({ 7, 8 });
+
+	std::array<int, 3> target = { 0, 0, 0 };
+	target << queue;
+	ADS_CHECK(target[0] == 7 && target[1] == 8 && target[2] == 0);
+	ADS_CHECK(queue.empty());
+}
+
+int main()
+{
+	testDrainIntoVector();
+	testDrainIntoBitVector();
+	testDrainIntoArray();
+
+	return Test::result();
+}
@@ -0,0 +1,276 @@
+#include "Test.h"
+#include "FixedQueue.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace ADS;
+
+using AllTrackers = Trackers<SumTracker<long>, MinMaxTracker<int>, MomentTracker<double>, EWMATracker<double>>;
+using TrackedQueue = FixedQueue<int, ModCapacity, AllTrackers>;
+
+// the exponentially weighted average of every element pushed since the trackers last started over, recomputed alongside the queue
+struct EWMAModel
+{
+	double value = 0.0;
+	bool empty = true;
+
+	void push(int elem, double alpha)
+	{
+		value = empty ? (double)elem : value + alpha * ((double)elem - value);
+		empty = false;
+	}
+
+	// clear and resize start over from the elements left in the queue
+	void restart(const TrackedQueue& queue)
+	{
+		empty = true;
+		value = 0.0;
+
+		for (int elem : queue)
+			push(elem, queue.alpha());
+	}
+};
+
+// the sum, extrema, variance and average kept by the trackers must match a scan of the queue
+bool trackersMatch(TrackedQueue& queue, const EWMAModel& ewma)
+{
+	std::vector<int> elements(queue.begin(), queue.end());
+
+	if (elements.empty())
+		return queue.sum() == 0 && queue.variance() == 0.0 && queue.ewma() == ewma.value;
+
+	auto max = std::max_element(elements.begin(), elements.end());
+	auto min = std::min_element(elements.begin(), elements.end());
+
+	double mean = std::accumulate(elements.begin(), elements.end(), 0.0) / (double)elements.size();
+	double squared_diff = 0.0;
+
+	for (int elem : elements)
+		squared_diff += ((double)elem - mean) * ((double)elem - mean);
+
+	double variance = squared_diff / (double)elements.size();
+
+	return queue.sum() == std::accumulate(elements.begin(), elements.end(), 0L)
+		&& queue.max() == *max && queue.iOfMax() == (size_t)(max - elements.begin())
+		&& queue.min() == *min && queue.iOfMin() == (size_t)(min - elements.begin())
+		&& std::abs(queue.variance() - variance) <= 1e-9 * (1.0 + variance)
+		&& std::abs(queue.ewma() - ewma.value) <= 1e-9 * (1.0 + std::abs(ewma.value));
+}
+
+// the trackers of two queues which were given the same elements in a different way have to agree exactly
+bool trackersEqual(TrackedQueue& a, TrackedQueue& b)
+{
+	return a.toVector() == b.toVector() && a.sum() == b.sum()
+		&& (a.empty() || (a.max() == b.max() && a.iOfMax() == b.iOfMax() && a.min() == b.min() && a.iOfMin() == b.iOfMin()))
+		&& a.variance() == b.variance() && a.ewma() == b.ewma();
+}
+
+// the nearest rank method, on a sorted copy of the queue
+template<typename TQueue>
+int sortedQuantile(const TQueue& queue, double q)
+{
+	std::vector<int> sorted(queue.begin(), queue.end());
+	std::sort(sorted.begin(), sorted.end());
+
+	size_t rank = (size_t)std::ceil(q * (double)sorted.size());
+	return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+template<typename TQueue>
+bool quantilesMatch(const TQueue& queue)
+{
+	if (queue.length() == 0)
+		return true;
+
+	for (double q : { 0.0, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 1.0 })
+		if (queue.quantile(q) != sortedQuantile(queue, q))
+			return false;
+
+	for (size_t rank = 0; rank < queue.length(); rank++)
+		if (queue.trackedRank(rank) != sortedQuantile(queue, (double)(rank + 1) / (double)queue.length()))
+			return false;
+
+	return true;
+}
+
+void testQuantileDuplicates()
+{
+	FixedQueue<int, ModCapacity, QuantileTracker<int>> queue(6);
+
+	// equal elements share a node, which is only removed with the last of them
+	queue.push_back({ 5, 5, 5, 1, 5, 1 });
+	ADS_CHECK(queue.quantile(0.0) == 1 && queue.quantile(0.34) == 5 && quantilesMatch(queue));
+
+	queue.pop_front(3);
+	ADS_CHECK(queue.median() == 1 && quantilesMatch(queue));
+
+	queue.pop_front(2);
+	ADS_CHECK(queue.quantile(0.0) == 1 && queue.quantile(1.0) == 1);
+
+	// overwriting the front with the value it already holds
+	queue.push_back({ 1, 1, 1, 1, 1, 1, 1 });
+	ADS_CHECK(queue.quantile(1.0) == 1 && quantilesMatch(queue));
+}
+
+void testQuantileOperations()
+{
+	FixedQueue<int, ModCapacity, QuantileTracker<int>> queue(8);
+	std::mt19937 rng(7);
+
+	// values from a small range, so most of them are duplicates
+	for (int step = 0; step < 2000; step++)
+	{
+		switch (rng() % 16)
+		{
+		case 0:
+			if (!queue.empty())
+				queue.pop_front(std::min<size_t>(queue.length(), rng() % 3 + 1));
+			break;
+		case 1:
+			if (rng() % 8 == 0)
+				queue.clear();
+			break;
+		case 2:
+			// both growing and shrinking, which drops the elements at the back
+			queue.resize(rng() % 12 + 1);
+			break;
+		case 3:
+		{
+			std::vector<int> values(rng() % 20);
+
+			for (int& value : values)
+				value = (int)(rng() % 10) - 5;
+
+			queue.push_back(values);
+			break;
+		}
+		default:
+			queue.push_back((int)(rng() % 10) - 5);
+		}
+
+		ADS_CHECK(quantilesMatch(queue));
+	}
+}
+
+void testTrackerOperations()
+{
+	TrackedQueue queue(5);
+	EWMAModel ewma;
+	std::mt19937 rng(5);
+
+	ADS_CHECK(trackersMatch(queue, ewma));
+
+	// values from a small range, so the extrema occur more than once
+	for (int step = 0; step < 3000; step++)
+	{
+		switch (rng() % 16)
+		{
+		case 0:
+			if (!queue.empty())
+				queue.pop_front(std::min<size_t>(queue.length(), rng() % 3 + 1));
+			break;
+		case 1:
+			if (rng() % 8 == 0)
+			{
+				queue.clear();
+				ewma.restart(queue);
+			}
+			break;
+		case 2:
+			queue.resize(rng() % 8 + 1);
+			ewma.restart(queue);
+			break;
+		case 3:
+		{
+			std::vector<int> values(rng() % 12);
+
+			for (int& value : values)
+			{
+				value = (int)(rng() % 21) - 10;
+				ewma.push(value, queue.alpha());
+			}
+
+			queue.push_back(values);
+			break;
+		}
+		default:
+		{
+			int value = (int)(rng() % 21) - 10;
+			ewma.push(value, queue.alpha());
+			queue.push_back(value);
+		}
+		}
+
+		ADS_CHECK(trackersMatch(queue, ewma));
+	}
+}
+
+void testBulkPushOrder()
+{
+	TrackedQueue bulk(6);
+	TrackedQueue single(6);
+	std::mt19937 rng(6);
+
+	// the contiguous push notifies the trackers before copying the elements, in the order single pushes would.
+	// batches longer than the queue also pop elements of the same batch.
+	for (int round = 0; round < 500; round++)
+	{
+		std::vector<int> values(rng() % 15);
+
+		for (int& value : values)
+			value = (int)(rng() % 1000) - 500;
+
+		bulk.push_back(values);
+
+		for (int value : values)
+			single.push_back(value);
+
+		if (round % 7 == 0 && !bulk.empty())
+		{
+			bulk.pop_front();
+			single.pop_front();
+		}
+
+		ADS_CHECK(trackersEqual(bulk, single));
+	}
+}
+
+void testKahanSum()
+{
+	FixedQueue<double, ModCapacity, KahanSumTracker<double>> compensated(16);
+	FixedQueue<double, ModCapacity, SumTracker<double>> plain(16);
+	std::mt19937 rng(16);
+
+	// large and small magnitudes, where every overwrite loses low bits of a plain running sum
+	for (int i = 0; i < 100000; i++)
+	{
+		double value = (i % 3 == 0 ? 1e9 : 0.0) + (double)(rng() % 1000) * 0.001;
+		compensated.push_back(value);
+		plain.push_back(value);
+	}
+
+	long double exact = 0.0L;
+
+	for (double value : compensated)
+		exact += value;
+
+	ADS_CHECK(std::abs(compensated.sum() - (double)exact) <= 1e-6);
+	ADS_CHECK(std::abs(compensated.sum() - (double)exact) <= std::abs(plain.sum() - (double)exact));
+
+	compensated.clear();
+	ADS_CHECK(compensated.sum() == 0.0);
+}
+
+int main()
+{
+	testQuantileDuplicates();
+	testQuantileOperations();
+	testTrackerOperations();
+	testBulkPushOrder();
+	testKahanSum();
+
+	return Test::result();
+}
@@ -0,0 +1,158 @@
+#include "Test.h"
+#include "MPMCFixedQueue.h"
+#include <atomic>
+#include <string>
+#include <vector>
+
+using namespace ADS;
+
+template<typename TCapacity>
+void testSmallSizes()
+{
+	// a single slot can not tell a full queue from an empty one, so sizes below 2 are raised to 2
+	for (size_t size : { 0, 1, 2 })
+	{
+		MPMCFixedQueue<int, TCapacity> queue(size);
+		ADS_CHECK(queue.size() == 2);
+
+		for (int lap = 0; lap < 5; lap++)
+		{
+			ADS_CHECK(queue.try_push(lap * 10));
+			ADS_CHECK(queue.try_push(lap * 10 + 1));
+			ADS_CHECK(!queue.try_push(-1));
+			ADS_CHECK(queue.full());
+
+			int value = -1;
+			ADS_CHECK(queue.try_pop(value) && value == lap * 10);
+			ADS_CHECK(queue.try_pop(value) && value == lap * 10 + 1);
+			ADS_CHECK(!queue.try_pop(value));
+			ADS_CHECK(queue.empty());
+		}
+	}
+}
+
+template<typename TCapacity>
+void testPushBackOverwrites()
+{
+	for (size_t size : { 1, 2, 5 })
+	{
+		MPMCFixedQueue<std::string, TCapacity> queue(size);
+
+		// wraps around the buffer several times, every push_back to the full queue drops the front
+		for (int i = 0; i < 50; i++)
+			queue.push_back(std::to_string(i));
+
+		ADS_CHECK(queue.full());
+
+		std::string value;
+
+		for (size_t i = 50 - queue.size(); i < 50; i++)
+			ADS_CHECK(queue.try_pop(value) && value == std::to_string(i));
+
+		ADS_CHECK(!queue.try_pop(value));
+	}
+}
+
+template<typename TCapacity>
+void testWrapBoundary()
+{
+	MPMCFixedQueue<int, TCapacity> queue(4);
+	int next_push = 0;
+	int next_pop = 0;
+
+	// fills to every length at every offset of the front
+	for (int round = 0; round < 40; round++)
+	{
+		size_t count = round % 4 + 1;
+
+		for (size_t i = 0; i < count; i++)
+			ADS_CHECK(queue.try_push(next_push++));
+
+		ADS_CHECK(queue.length() == count);
+
+		int value;
+
+		for (size_t i = 0; i < count; i++)
+			ADS_CHECK(queue.try_pop(value) && value == next_pop++);
+	}
+}
+
+// every producer pushes its id in the upper bits and an increasing counter in the lower bits.
+// each consumer must see the elements of a producer in increasing order, and every element must be popped exactly once.
+template<typename TCapacity>
+void testStress(size_t size, size_t producers, size_t consumers)
+{
+	constexpr uint64_t per_producer = 20000;
+	MPMCFixedQueue<uint64_t, TCapacity> queue(size);
+
+	std::atomic<uint64_t> popped = 0;
+	std::vector<std::vector<uint64_t>> received(consumers);
+	std::vector<std::thread> threads;
+
+	for (uint64_t p = 0; p < producers; p++)
+	{
+		threads.emplace_back([&, p] {
+			for (uint64_t i = 0; i < per_producer; i++)
+				while (!queue.try_push(p << 32 | i))
+					Test::backoff();
+		});
+	}
+
+	for (size_t c = 0; c < consumers; c++)
+	{
+		threads.emplace_back([&, c] {
+			uint64_t value;
+
+			while (popped.load() < producers * per_producer)
+			{
+				if (queue.try_pop(value))
+				{
+					received[c].push_back(value);
+					popped++;
+				}
+				else
+					Test::backoff();
+			}
+		});
+	}
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	std::vector<size_t> seen(producers * per_producer, 0);
+	bool ordered = true;
+
+	for (const std::vector<uint64_t>& values : received)
+	{
+		std::vector<int64_t> last(producers, -1);
+
+		for (uint64_t value : values)
+		{
+			uint64_t producer = value >> 32;
+			int64_t counter = (int64_t)(value & 0xffffffff);
+
+			ordered &= counter > last[producer];
+			last[producer] = counter;
+			seen[producer * per_producer + counter]++;
+		}
+	}
+
+	ADS_CHECK(ordered);
+	ADS_CHECK(std::all_of(seen.begin(), seen.end(), [](size_t count) { return count == 1; }));
+	ADS_CHECK(queue.empty());
+}
+
+int main()
+{
+	testSmallSizes<ModCapacity>();
+	testSmallSizes<Pow2Capacity>();
+	testPushBackOverwrites<ModCapacity>();
+	testPushBackOverwrites<Pow2Capacity>();
+	testWrapBoundary<ModCapacity>();
+	testWrapBoundary<Pow2Capacity>();
+	testStress<ModCapacity>(2, 3, 3);
+	testStress<ModCapacity>(7, 4, 2);
+	testStress<Pow2Capacity>(64, 2, 4);
+
+	return Test::result();
+}
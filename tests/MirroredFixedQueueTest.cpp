@@ -0,0 +1,131 @@
+#include "Test.h"
+#include "MirroredFixedQueue.h"
+#include <numeric>
+#include <vector>
+#include <unistd.h>
+
+using namespace ADS;
+
+// 12 bytes, which does not divide the page size
+struct Sample
+{
+	int32_t channel;
+	float value;
+	uint32_t sequence;
+};
+
+// every element is readable at the same offset from data(), from operator[] and from the iterator
+template<typename TQueue>
+bool contiguous(const TQueue& queue)
+{
+	bool equal = true;
+	auto it = queue.begin();
+
+	for (size_t i = 0; i < queue.length(); i++, ++it)
+		equal &= queue.data()[i] == queue[i] && *it == queue[i];
+
+	auto [first, second] = queue.spans();
+	return equal && first.data() == queue.data() && first.size() == queue.length() && second.empty();
+}
+
+// moves the front of an empty queue to offset
+template<typename TQueue>
+void moveFront(TQueue& queue, size_t offset)
+{
+	if (offset == 0)
+		return;
+
+	queue.push_back(std::vector<int>(offset, -1));
+	queue.pop_front(offset);
+}
+
+void testSizes()
+{
+	size_t page_elements = (size_t)sysconf(_SC_PAGESIZE) / sizeof(int);
+
+	for (size_t size : { 0, 1, 2 })
+	{
+		MirroredFixedQueue<int> queue(size);
+		ADS_CHECK(queue.size() == page_elements);
+
+		for (int i = 0; i < (int)page_elements * 3; i++)
+			queue.push_back(i);
+
+		ADS_CHECK(queue.full());
+		ADS_CHECK(queue.front() == (int)page_elements * 2);
+		ADS_CHECK(contiguous(queue));
+	}
+
+	MirroredFixedQueue<Sample> samples(1);
+	ADS_CHECK(samples.size() * sizeof(Sample) % (size_t)sysconf(_SC_PAGESIZE) == 0);
+
+	for (uint32_t i = 0; i < samples.size() + 5; i++)
+		samples.push_back({ 1, 0.5f, i });
+
+	ADS_CHECK(samples.data()[samples.length() - 1].sequence == samples.size() + 4);
+	ADS_CHECK(samples.back().sequence == samples.size() + 4);
+}
+
+void testWrapBoundary()
+{
+	MirroredFixedQueue<int, SumTracker<long>> queue(1);
+	size_t size = queue.size();
+	long next = 0;
+
+	// moves the front to every offset around the end of the buffer, pushing single elements and bulk ranges across it
+	for (size_t offset = size - 4; offset < size + 4; offset++)
+	{
+		queue.clear();
+		moveFront(queue, offset % size);
+
+		std::vector<int> batch(size - 2);
+		std::iota(batch.begin(), batch.end(), (int)next);
+		queue.push_back(batch);
+		next += batch.size();
+
+		queue.push_back((int)next++);
+		queue.push_back((int)next++);
+		queue.push_back((int)next++);
+
+		ADS_CHECK(queue.full());
+		ADS_CHECK(queue.back() == next - 1);
+		ADS_CHECK(queue.front() == next - (long)size);
+		ADS_CHECK(contiguous(queue));
+		ADS_CHECK(queue.sum() == std::accumulate(queue.data(), queue.data() + queue.length(), 0L));
+	}
+}
+
+void testReservePublish()
+{
+	MirroredFixedQueue<int> queue(1);
+	size_t size = queue.size();
+
+	moveFront(queue, size - 3);
+
+	// the reserved slots cross the end of the buffer, but are returned as a single span
+	auto [first, second] = queue.reserve(10);
+	ADS_CHECK(first.size() == 10 && second.empty());
+
+	for (int i = 0; i < 10; i++)
+		first[i] = i;
+
+	queue.publish(10);
+	ADS_CHECK(queue.length() == 10);
+	ADS_CHECK(queue[0] == 0 && queue[9] == 9);
+	ADS_CHECK(contiguous(queue));
+
+	auto [peeked, rest] = queue.peek(10);
+	ADS_CHECK(peeked.size() == 10 && rest.empty() && peeked[9] == 9);
+
+	queue.consume(10);
+	ADS_CHECK(queue.empty());
+}
+
+int main()
+{
+	testSizes();
+	testWrapBoundary();
+	testReservePublish();
+
+	return Test::result();
+}
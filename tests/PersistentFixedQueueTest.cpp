@@ -0,0 +1,212 @@
+#include "Test.h"
+#include "PersistentFixedQueue.h"
+#include <filesystem>
+#include <stdexcept>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+using namespace ADS;
+
+// offsets into the file, see FILE LAYOUT in PersistentFixedQueue.h
+constexpr off_t STATE_OFFSET[2] = { 32, 64 };
+constexpr off_t CHECKSUM_OFFSET = 24;
+
+std::string g_path;
+
+std::vector<int> elements(const PersistentFixedQueue<int>& queue)
+{
+	return std::vector<int>(queue.begin(), queue.end());
+}
+
+// runs func in a child process which exits without running any destructors, like a process that crashed.
+// func has to leak the queue it opens, as its destructor would commit when func returns.
+template<typename TFunc>
+void crashAfter(TFunc func)
+{
+	pid_t pid = fork();
+
+	if (pid == 0)
+	{
+		func();
+		_exit(0);
+	}
+
+	int status = 0;
+	waitpid(pid, &status, 0);
+	ADS_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
+
+void writeAt(off_t offset, const void* data, size_t bytes)
+{
+	int fd = ::open(g_path.c_str(), O_RDWR);
+	ADS_CHECK(pwrite(fd, data, bytes, offset) == (ssize_t)bytes);
+	close(fd);
+}
+
+void corruptState(int index)
+{
+	uint64_t garbage = 0x1234;
+	writeAt(STATE_OFFSET[index] + CHECKSUM_OFFSET, &garbage, sizeof(garbage));
+}
+
+template<typename TFunc>
+bool throwsRuntimeError(TFunc func)
+{
+	try
+	{
+		func();
+	}
+	catch (const std::runtime_error&)
+	{
+		return true;
+	}
+
+	return false;
+}
+
+void testReopenAcrossWrap()
+{
+	for (size_t size : { 1, 2, 5 })
+	{
+		std::filesystem::remove(g_path);
+		std::vector<int> expected;
+
+		// every round wraps the buffer and is checked after reopening the file
+		for (int round = 0; round < 4; round++)
+		{
+			PersistentFixedQueue<int> queue(g_path, size);
+			ADS_CHECK(elements(queue) == expected);
+
+			for (int i = 0; i < (int)size + 3; i++)
+				queue.push_back(round * 100 + i);
+
+			if (round % 2 == 1)
+				queue.pop_front();
+
+			expected = elements(queue);
+		}
+
+		PersistentFixedQueue<int> queue(g_path, size);
+		ADS_CHECK(elements(queue) == expected);
+	}
+}
+
+void testCrashBeforeCommit()
+{
+	std::filesystem::remove(g_path);
+
+	crashAfter([] {
+		PersistentFixedQueue<int>& queue = *new PersistentFixedQueue<int>(g_path, 4);
+		queue.push_back({ 1, 2, 3 });
+		queue.commit();
+		// 5 and 6 overwrite 1 and 2, which belong to the committed state
+		queue.push_back({ 4, 5, 6 });
+	});
+
+	PersistentFixedQueue<int> queue(g_path, 4);
+	ADS_CHECK(elements(queue) == std::vector<int>({ 5, 6, 3 }));
+}
+
+void testCrashDuringCommit()
+{
+	std::filesystem::remove(g_path);
+
+	crashAfter([] {
+		PersistentFixedQueue<int>& queue = *new PersistentFixedQueue<int>(g_path, 4);
+		// the first commit writes state 1, the second state 0
+		queue.push_back({ 1, 2 });
+		queue.commit();
+		queue.push_back(3);
+		queue.commit();
+	});
+
+	// a torn second commit falls back to the first one
+	corruptState(0);
+
+	{
+		PersistentFixedQueue<int> queue(g_path, 4);
+		ADS_CHECK(elements(queue) == std::vector<int>({ 1, 2 }));
+	}
+
+	// the destructor committed again, so the file is consistent afterwards
+	PersistentFixedQueue<int> queue(g_path, 4);
+	ADS_CHECK(elements(queue) == std::vector<int>({ 1, 2 }));
+}
+
+void testCrashDuringCreation()
+{
+	size_t file_size = 0;
+
+	{
+		std::filesystem::remove(g_path);
+		PersistentFixedQueue<int> queue(g_path, 16);
+		file_size = std::filesystem::file_size(g_path);
+	}
+
+	// a crash right after resizing the file leaves it zero filled
+	std::filesystem::remove(g_path);
+	{
+		int fd = ::open(g_path.c_str(), O_RDWR | O_CREAT, 0600);
+		ADS_CHECK(ftruncate(fd, file_size) == 0);
+		close(fd);
+	}
+
+	{
+		PersistentFixedQueue<int> queue(g_path, 16);
+		ADS_CHECK(queue.empty());
+		queue.push_back({ 7, 8 });
+	}
+	{
+		PersistentFixedQueue<int> queue(g_path, 16);
+		ADS_CHECK(elements(queue) == std::vector<int>({ 7, 8 }));
+	}
+
+	// a crash while the header was written leaves every field but the magic, which is written last
+	uint64_t zero = 0;
+	writeAt(0, &zero, sizeof(zero));
+
+	PersistentFixedQueue<int> queue(g_path, 16);
+	ADS_CHECK(queue.empty());
+}
+
+void testRejectedFiles()
+{
+	std::filesystem::remove(g_path);
+	{
+		PersistentFixedQueue<int> queue(g_path, 8);
+		queue.push_back({ 1, 2, 3 });
+	}
+
+	ADS_CHECK(throwsRuntimeError([] { PersistentFixedQueue<int> queue(g_path, 9); }));
+	ADS_CHECK(throwsRuntimeError([] { PersistentFixedQueue<double> queue(g_path, 8); }));
+
+	corruptState(0);
+	corruptState(1);
+	ADS_CHECK(throwsRuntimeError([] { PersistentFixedQueue<int> queue(g_path, 8); }));
+
+	// a file which is not a queue at all
+	std::filesystem::remove(g_path);
+	{
+		int fd = ::open(g_path.c_str(), O_RDWR | O_CREAT, 0600);
+		ADS_CHECK(write(fd, "not a queue", 11) == 11);
+		close(fd);
+	}
+
+	ADS_CHECK(throwsRuntimeError([] { PersistentFixedQueue<int> queue(g_path, 8); }));
+}
+
+int main()
+{
+	g_path = (std::filesystem::temp_directory_path() / ("ADS-PersistentFixedQueueTest-" + std::to_string(getpid()))).string();
+
+	testReopenAcrossWrap();
+	testCrashBeforeCommit();
+	testCrashDuringCommit();
+	testCrashDuringCreation();
+	testRejectedFiles();
+
+	std::filesystem::remove(g_path);
+	return Test::result();
+}
@@ -0,0 +1,157 @@
+#include "Test.h"
+#include "SPSCFixedQueue.h"
+#include <string>
+#include <vector>
+
+using namespace ADS;
+
+template<typename TCapacity>
+void testSmallSizes()
+{
+	for (size_t size : { 1, 2 })
+	{
+		SPSCFixedQueue<int, TCapacity> queue(size);
+		ADS_CHECK(queue.size() == size);
+
+		for (int lap = 0; lap < 5; lap++)
+		{
+			for (size_t i = 0; i < size; i++)
+				ADS_CHECK(queue.try_push(lap * 10 + (int)i));
+
+			ADS_CHECK(queue.full());
+			ADS_CHECK(!queue.try_push(-1));
+
+			int value = -1;
+
+			for (size_t i = 0; i < size; i++)
+			{
+				ADS_CHECK(queue.try_pop(value));
+				ADS_CHECK(value == lap * 10 + (int)i);
+			}
+
+			ADS_CHECK(queue.empty());
+			ADS_CHECK(!queue.try_pop(value));
+		}
+	}
+}
+
+template<typename TCapacity>
+void testWrapBoundary()
+{
+	SPSCFixedQueue<int, TCapacity> queue(8);
+	int next_push = 0;
+	int next_pop = 0;
+
+	// batches of every length, starting at every offset, so batches cross the end of the buffer at every position
+	for (size_t offset = 0; offset < 8; offset++)
+	{
+		for (size_t count = 1; count <= 8; count++)
+		{
+			std::vector<int> batch(count);
+
+			for (int& value : batch)
+				value = next_push++;
+
+			ADS_CHECK(queue.try_push(batch.begin(), batch.end()) == count);
+			ADS_CHECK(queue.length() == count);
+
+			int popped[8];
+			ADS_CHECK(queue.try_pop(popped, 8) == count);
+
+			for (size_t i = 0; i < count; i++)
+				ADS_CHECK(popped[i] == next_pop++);
+		}
+
+		ADS_CHECK(queue.try_push(next_push));
+		int value;
+		ADS_CHECK(queue.try_pop(value) && value == next_push);
+		next_push++;
+		next_pop++;
+	}
+}
+
+void testBulkPartial()
+{
+	SPSCFixedQueue<std::string> queue(4);
+	std::vector<std::string> source = { "a", "b", "c", "d", "e", "f" };
+
+	ADS_CHECK(queue.try_push(source.begin(), source.begin() + 3) == 3);
+	// only one slot is left
+	ADS_CHECK(queue.try_push(source.begin() + 3, source.end()) == 1);
+	ADS_CHECK(queue.try_push(source.begin(), source.end()) == 0);
+
+	std::string popped[6];
+	ADS_CHECK(queue.try_pop(popped, 6) == 4);
+	ADS_CHECK(popped[0] == "a" && popped[3] == "d");
+	ADS_CHECK(queue.try_pop(popped, 6) == 0);
+}
+
+template<typename TCapacity>
+void testStress(size_t size)
+{
+	constexpr uint64_t count = 200000;
+	SPSCFixedQueue<uint64_t, TCapacity> queue(size);
+
+	std::thread producer([&] {
+		uint64_t batch[7];
+
+		for (uint64_t next = 0; next < count;)
+		{
+			// alternate between single and bulk pushes
+			if (next % 3 == 0)
+			{
+				if (queue.try_push(next))
+					next++;
+				else
+					Test::backoff();
+
+				continue;
+			}
+
+			size_t batch_size = std::min<uint64_t>(7, count - next);
+
+			for (size_t i = 0; i < batch_size; i++)
+				batch[i] = next + i;
+
+			size_t pushed = queue.try_push(batch, batch + batch_size);
+
+			if (pushed == 0)
+				Test::backoff();
+
+			next += pushed;
+		}
+	});
+
+	uint64_t expected = 0;
+	bool ordered = true;
+	uint64_t batch[5];
+
+	while (expected < count)
+	{
+		size_t popped = queue.try_pop(batch, 5);
+
+		if (popped == 0)
+			Test::backoff();
+
+		for (size_t i = 0; i < popped; i++)
+			ordered &= batch[i] == expected++;
+	}
+
+	producer.join();
+
+	ADS_CHECK(ordered);
+	ADS_CHECK(queue.empty());
+}
+
+int main()
+{
+	testSmallSizes<ModCapacity>();
+	testSmallSizes<Pow2Capacity>();
+	testWrapBoundary<ModCapacity>();
+	testWrapBoundary<Pow2Capacity>();
+	testBulkPartial();
+	testStress<ModCapacity>(3);
+	testStress<Pow2Capacity>(64);
+
+	return Test::result();
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <coroutine>
+#include <deque>
+#include <utility>
+#include <exception>
+#include <vector>
+
+// a single threaded scheduler for the coroutine tests, which the channel benchmark also uses.
+// tasks are started by run in the order they were spawned, and run until they finish or suspend.
+// a task suspended on a FixedQueueChannel is resumed by the channel itself, and yield puts a task back at the end of the ready queue.
+namespace Test
+{
+	class Task
+	{
+	public:
+		struct promise_type
+		{
+			Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+			std::suspend_always initial_suspend() { return {}; }
+			std::suspend_always final_suspend() noexcept { return {}; }
+			void return_void() {}
+			void unhandled_exception() { std::terminate(); }
+		};
+
+		Task(Task&& other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
+		~Task() { if (m_handle) m_handle.destroy(); }
+
+		std::coroutine_handle<> handle() const { return m_handle; }
+		bool done() const { return m_handle.done(); }
+
+	protected:
+		explicit Task(std::coroutine_handle<promise_type> handle) : m_handle(handle) {}
+
+		std::coroutine_handle<promise_type> m_handle;
+	};
+
+	class Scheduler
+	{
+	public:
+		// the task is started by the next call to run.
+		void spawn(Task&& task)
+		{
+			m_ready.push_back(task.handle());
+			m_tasks.push_back(std::move(task));
+		}
+
+		// co_await suspends the task and resumes it after all other ready tasks ran.
+		auto yield()
+		{
+			struct YieldAwaiter
+			{
+				Scheduler& scheduler;
+
+				bool await_ready() const { return false; }
+				void await_suspend(std::coroutine_handle<> handle) { scheduler.m_ready.push_back(handle); }
+				void await_resume() const {}
+			};
+
+			return YieldAwaiter{ *this };
+		}
+
+		// resumes ready tasks until there are none left, and returns true if every task finished.
+		bool run()
+		{
+			while (!m_ready.empty())
+			{
+				std::coroutine_handle<> handle = m_ready.front();
+				m_ready.pop_front();
+				handle.resume();
+			}
+
+			for (const Task& task : m_tasks)
+				if (!task.done())
+					return false;
+
+			return true;
+		}
+
+	protected:
+		std::deque<std::coroutine_handle<>> m_ready;
+		std::vector<Task> m_tasks;
+	};
+}
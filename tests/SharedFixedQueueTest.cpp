@@ -0,0 +1,178 @@
+#include "Test.h"
+#include "SharedFixedQueue.h"
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+#include <unistd.h>
+#include <sys/wait.h>
+
+using namespace ADS;
+
+const std::string NAME = "/ADS-SharedFixedQueueTest-" + std::to_string(getpid());
+
+// runs func in a child process, which exits with 1 if func returns false.
+// the child exits without running the destructors of the parent's objects, which would remove the name.
+template<typename TFunc>
+pid_t spawn(TFunc func)
+{
+	pid_t pid = fork();
+
+	if (pid == 0)
+		_exit(func() ? 0 : 1);
+
+	return pid;
+}
+
+bool exitedCleanly(pid_t pid)
+{
+	int status = 0;
+	waitpid(pid, &status, 0);
+	return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+template<typename TException, typename TFunc>
+bool throws(TFunc func)
+{
+	try
+	{
+		func();
+	}
+	catch (const TException&)
+	{
+		return true;
+	}
+
+	return false;
+}
+
+template<typename TCapacity>
+void testSmallSizes()
+{
+	// a single slot can not tell a full queue from an empty one, so sizes below 2 are raised to 2
+	for (size_t size : { 1, 2 })
+	{
+		SharedFixedQueue<int, false, TCapacity> queue(NAME, size);
+		SharedFixedQueue<int, false, TCapacity> attached(NAME);
+		ADS_CHECK(queue.size() == 2 && attached.size() == 2);
+
+		for (int lap = 0; lap < 5; lap++)
+		{
+			ADS_CHECK(attached.try_push(lap * 10));
+			ADS_CHECK(attached.try_push(lap * 10 + 1));
+			ADS_CHECK(!attached.try_push(-1));
+			ADS_CHECK(queue.full());
+
+			int value = -1;
+			ADS_CHECK(queue.try_pop(value) && value == lap * 10);
+			ADS_CHECK(queue.try_pop(value) && value == lap * 10 + 1);
+			ADS_CHECK(!queue.try_pop(value));
+		}
+	}
+}
+
+void testWrapBoundary()
+{
+	SharedFixedQueue<int> queue(NAME, 5);
+	int next_push = 0;
+	int next_pop = 0;
+
+	// fills to every length at every offset of the front, popping in bulk across the end of the buffer
+	for (int round = 0; round < 25; round++)
+	{
+		size_t count = round % 5 + 1;
+
+		for (size_t i = 0; i < count; i++)
+			ADS_CHECK(queue.try_push(next_push++));
+
+		int popped[5];
+		ADS_CHECK(queue.try_pop(popped, 5) == count);
+
+		for (size_t i = 0; i < count; i++)
+			ADS_CHECK(popped[i] == next_pop++);
+	}
+}
+
+void testAttachValidation()
+{
+	{
+		SharedFixedQueue<int> queue(NAME, 6);
+
+		// creating a second queue under the same name fails
+		ADS_CHECK(throws<std::system_error>([] { SharedFixedQueue<int> other(NAME, 6); }));
+
+		// 6 is not a power of two, so Pow2Capacity would wrap it with the wrong mask
+		ADS_CHECK(throws<std::runtime_error>([] { SharedFixedQueue<int, false, Pow2Capacity> attached(NAME); }));
+		ADS_CHECK(throws<std::runtime_error>([] { SharedFixedQueue<int64_t> attached(NAME); }));
+		ADS_CHECK(throws<std::runtime_error>([] { SharedFixedQueue<int, true> attached(NAME); }));
+
+		SharedFixedQueue<int> attached(NAME);
+		ADS_CHECK(attached.size() == 6);
+	}
+
+	// a power of two created with ModCapacity can be attached with Pow2Capacity, as both wrap it the same way
+	SharedFixedQueue<int> queue(NAME, 8);
+	SharedFixedQueue<int, false, Pow2Capacity> attached(NAME);
+	ADS_CHECK(attached.size() == 8);
+}
+
+// every producer process pushes its id in the upper bits and an increasing counter in the lower bits.
+// the consumer must see the elements of every producer in order, and every element exactly once.
+template<bool multi_producer>
+void testStress(size_t size, size_t producers, bool wakeup)
+{
+	constexpr uint64_t per_producer = 20000;
+	SharedFixedQueue<uint64_t, multi_producer> queue(NAME, size, wakeup);
+	std::vector<pid_t> children;
+
+	for (uint64_t p = 0; p < producers; p++)
+	{
+		children.push_back(spawn([p] {
+			SharedFixedQueue<uint64_t, multi_producer> attached(NAME);
+
+			for (uint64_t i = 0; i < per_producer; i++)
+				while (!attached.try_push(p << 32 | i))
+					Test::backoff();
+
+			return true;
+		}));
+	}
+
+	std::vector<uint64_t> next(producers, 0);
+	bool ordered = true;
+
+	for (uint64_t received = 0; received < producers * per_producer; received++)
+	{
+		uint64_t value = 0;
+
+		if (wakeup)
+			ADS_CHECK(queue.pop_wait_for(value, std::chrono::seconds(10)));
+		else
+			while (!queue.try_pop(value))
+				Test::backoff();
+
+		uint64_t producer = value >> 32;
+		ordered &= producer < producers && (value & 0xffffffff) == next[producer]++;
+	}
+
+	for (pid_t child : children)
+		ADS_CHECK(exitedCleanly(child));
+
+	ADS_CHECK(ordered);
+	ADS_CHECK(queue.empty());
+}
+
+int main()
+{
+	SharedFixedQueue<int>::remove(NAME);
+
+	testSmallSizes<ModCapacity>();
+	testSmallSizes<Pow2Capacity>();
+	testWrapBoundary();
+	testAttachValidation();
+	testStress<false>(3, 1, false);
+	testStress<false>(64, 1, true);
+	testStress<true>(2, 3, false);
+	testStress<true>(16, 4, true);
+
+	return Test::result();
+}
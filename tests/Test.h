@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdio>
+#include <thread>
+
+// a minimal check harness shared by the tests in this directory.
+// every test is its own executable, which returns 1 if any check failed, so ctest can run them without a test library.
+namespace Test
+{
+	inline int& failures()
+	{
+		static int count = 0;
+		return count;
+	}
+
+	inline int result()
+	{
+		if (failures() > 0)
+			std::printf("%d checks failed\n", failures());
+
+		return failures() > 0 ? 1 : 0;
+	}
+
+	// used when spinning on a concurrent queue, so the test also finishes on a machine with fewer cores than threads.
+	inline void backoff()
+	{
+		std::this_thread::yield();
+	}
+}
+
+// unlike assert, a check is not compiled away in release builds, and the test continues after it fails.
+#define ADS_CHECK(expr) \
+	((expr) ? (void)0 : (void)(std::printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #expr), Test::failures()++))
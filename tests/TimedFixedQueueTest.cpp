@@ -0,0 +1,60 @@
+#include "Test.h"
+#include "TimedFixedQueue.h"
+#include <chrono>
+#include <vector>
+
+using namespace ADS;
+
+using namespace std::chrono_literals;
+
+// a clock which only moves when the test advances it
+struct ManualClock
+{
+	using duration = std::chrono::milliseconds;
+	using rep = duration::rep;
+	using period = duration::period;
+	using time_point = std::chrono::time_point<ManualClock>;
+
+	static constexpr bool is_steady = true;
+
+	static time_point& current()
+	{
+		static time_point time;
+		return time;
+	}
+
+	static time_point now() { return current(); }
+	static void advance(duration time) { current() += time; }
+};
+
+void testForwardedAggregates()
+{
+	TimedFixedQueue<int, ModCapacity, Trackers<SumTracker<long>, MinMaxTracker<int>>, ManualClock> queue(10ms, 8);
+
+	for (int value : { 9, 1, 5, 7 })
+	{
+		queue.push_back(value);
+		ManualClock::advance(4ms);
+	}
+
+	// 9 and 1 are older than the window by now, and are evicted by the aggregates themselves
+	ADS_CHECK(queue.sum() == 12);
+	ADS_CHECK(queue.max() == 7 && queue.iOfMax() == 1);
+	ADS_CHECK(queue.min() == 5 && queue.iOfMin() == 0);
+	ADS_CHECK(queue.avg() == 6 && queue.median() == 5 && queue.quantile(1.0) == 7);
+	ADS_CHECK(queue.variance() == 1.0 && queue.stddev() == 1.0);
+
+	// the const view is meant for reading the elements
+	std::vector<int> elements = queue.elements().toVector();
+	ADS_CHECK(elements == std::vector<int>({ 5, 7 }));
+
+	ManualClock::advance(10ms);
+	ADS_CHECK(queue.empty() && queue.sum() == 0);
+}
+
+int main()
+{
+	testForwardedAggregates();
+
+	return Test::result();
+}